@@ -0,0 +1,99 @@
+#include "AdmissionBench.h"
+#include "Bench.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MPSCQueue.h"
+
+typedef std::shared_ptr<int> Item;
+
+static const int PUSHES_PER_PRODUCER = 200000;
+
+
+// Baseline: what Scheduler::addProcess did before, one lock per push.
+class LockedQueue {
+public:
+    bool push(Item item) {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        bool wasEmpty = this->_queue.empty();
+        this->_queue.push(item);
+        return wasEmpty;
+    }
+
+    size_t drain(std::vector<Item>& out) {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        size_t count = this->_queue.size();
+        while (!this->_queue.empty()) {
+            out.push_back(this->_queue.front());
+            this->_queue.pop();
+        }
+        return count;
+    }
+
+private:
+    std::mutex mtx;
+    std::queue<Item> _queue;
+};
+
+template <typename Queue>
+static void runCase(std::string name, int producers) {
+    Queue queue;
+    std::atomic<bool> start{ false };
+    std::atomic<bool> done{ false };
+    std::vector<std::vector<long long>> latencies(producers);
+
+    // Consumer keeps draining the way the engine thread would.
+    std::thread consumer([&]() {
+        std::vector<Item> batch;
+        while (!done) {
+            batch.clear();
+            queue.drain(batch);
+        }
+        batch.clear();
+        queue.drain(batch);
+        });
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            Item item = std::make_shared<int>(p);
+            latencies[p].reserve(PUSHES_PER_PRODUCER);
+            while (!start) {}
+            for (int i = 0; i < PUSHES_PER_PRODUCER; i++) {
+                Bench::Clock::time_point t = Bench::Clock::now();
+                queue.push(item);
+                latencies[p].push_back(Bench::nanosSince(t));
+            }
+            });
+    }
+
+    Bench::Clock::time_point begin = Bench::Clock::now();
+    start = true;
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+    long long total = Bench::nanosSince(begin);
+    done = true;
+    consumer.join();
+
+    std::vector<long long> all;
+    for (int p = 0; p < producers; p++) {
+        all.insert(all.end(), latencies[p].begin(), latencies[p].end());
+    }
+    Bench::report(name + " x" + std::to_string(producers), (long long)producers * PUSHES_PER_PRODUCER, total, all);
+}
+
+void AdmissionBench::run() {
+    Bench::printHeader("process admission (push latency under contention)");
+    int producerCounts[] = { 1, 2, 4, 8 };
+    for (int producers : producerCounts) {
+        runCase<LockedQueue>("mutex queue", producers);
+        runCase<MPSCQueue<Item>>("lock-free MPSC queue", producers);
+    }
+}
@@ -0,0 +1,14 @@
+#pragma once
+#ifndef ADMISSIONBENCH_H
+#define ADMISSIONBENCH_H
+
+
+// Admission latency of the scheduler's lock-free MPSC queue against the
+// mutex-guarded queue it replaced, with several producer threads pushing
+// while one consumer drains.
+class AdmissionBench {
+public:
+    static void run();
+};
+
+#endif // !ADMISSIONBENCH_H
@@ -0,0 +1,274 @@
+#include "AllocatorBench.h"
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BuddyAllocator.h"
+#include "FlatAllocator.h"
+#include "FreeList.h"
+#include "IAllocator.h"
+#include "MemorySnapshot.h"
+#include "PagingAllocator.h"
+#include "PrintCommand.h"
+#include "Process.h"
+
+static const int MAX_MEMORY = 16384;
+static const int POOL_SIZE = 512;
+static const int OPS = 200000;
+static const int ACCESSES_PER_OP = 4;
+// Give up on a process that is stuck faulting after this many steps per instruction
+static const int STEPS_PER_INSTRUCTION = 3;
+// The free list model check: random allocate/release ops on a small space,
+// so the bitmap model can be rescanned after every one
+static const int MODEL_OPS = 200000;
+static const int MODEL_SIZE = 1024;
+
+typedef std::vector<std::shared_ptr<Process>> Pool;
+
+
+// Long enough that no process finishes (and stops touching memory) before
+// the last op
+static Pool makePool(std::string prefix, int count, int minMemory, int maxMemory) {
+    std::uniform_int_distribution<int> commandDistr(10000, 10000);
+    std::uniform_int_distribution<int> memoryDistr(minMemory, maxMemory);
+    std::uniform_int_distribution<int> pageDistr(1, 1);
+    Pool pool;
+    for (int i = 0; i < count; i++) {
+        pool.push_back(std::make_shared<Process>(prefix + std::to_string(i), commandDistr, memoryDistr, pageDistr));
+    }
+    return pool;
+}
+
+static IAllocator* makeAllocator(std::string allocator, std::string policy) {
+    if (allocator == "flat") return new FlatAllocator(MAX_MEMORY, policy);
+    if (allocator == "buddy") return new BuddyAllocator(MAX_MEMORY);
+    return new PagingAllocator(MAX_MEMORY, policy);
+}
+
+// Each op admits the next pool process, touches its memory a few times and
+// retires one resident process: the oldest for churn, a random one for the
+// mix. Pool processes are reused once retired, so construction stays out of
+// the timing.
+static void runCase(std::string name, IAllocator* allocator, Pool& pool, int resident, bool randomVictim) {
+    std::mt19937 generator(42);
+    std::deque<std::shared_ptr<Process>> live;
+    std::vector<long long> latencies;
+    latencies.reserve(OPS);
+    int failed = 0;
+    size_t next = 0;
+
+    Bench::Clock::time_point begin = Bench::Clock::now();
+    for (int op = 0; op < OPS; op++) {
+        // The pool is much larger than the resident set, so this one is not live
+        std::shared_ptr<Process>& process = pool[next];
+        next = (next + 1) % pool.size();
+
+        Bench::Clock::time_point t = Bench::Clock::now();
+        if (allocator->allocate(process)) {
+            for (int a = 0; a < ACCESSES_PER_OP; a++) {
+                if (allocator->access(process)) {
+                    process->execute();
+                }
+            }
+            live.push_back(process);
+        }
+        else {
+            failed++;
+        }
+        if (int(live.size()) > resident) {
+            size_t victim = randomVictim ? generator() % live.size() : 0;
+            allocator->deallocate(live[victim]);
+            live.erase(live.begin() + victim);
+        }
+        latencies.push_back(Bench::nanosSince(t));
+    }
+    long long total = Bench::nanosSince(begin);
+    Bench::report(name, OPS, total, latencies);
+
+    MemorySnapshot snapshot;
+    allocator->snapshot(snapshot);
+    std::printf("  %d of %d allocations failed; %d free, %d resident at the end\n",
+        failed, OPS, snapshot.externalFragmentation, snapshot.processCount);
+
+    for (size_t i = 0; i < live.size(); i++) {
+        allocator->deallocate(live[i]);
+    }
+}
+
+// One process on just two frames: an instruction that faults on both its
+// code and data page must get both in at once rather than evict one for the
+// other, so it always runs on the step after a fault.
+static void checkProgress(std::string replacement) {
+    std::uniform_int_distribution<int> commandDistr(1000, 1000);
+    std::uniform_int_distribution<int> memoryDistr(256, 256);
+    std::uniform_int_distribution<int> pageDistr(1, 1);
+    std::shared_ptr<Process> process = std::make_shared<Process>("alloc_two", commandDistr, memoryDistr, pageDistr);
+    IAllocator* allocator = new PagingAllocator(2 * 64, replacement);
+    allocator->allocate(process);
+    int steps = 0;
+    int faults = 0;
+    int mostFaults = 0;
+    int limit = process->getCommandListSize() * STEPS_PER_INSTRUCTION;
+    while (!process->hasFinished() && steps < limit) {
+        if (allocator->access(process)) {
+            process->execute();
+            faults = 0;
+        }
+        else {
+            mostFaults = std::max(mostFaults, ++faults);
+        }
+        steps++;
+    }
+    bool progressed = process->hasFinished() && mostFaults <= 1;
+    std::printf("  paging %s on 2 frames: %d of %d instructions in %d steps, at most %d faults in a row%s\n",
+        replacement.c_str(), process->getCommandCounter(), process->getCommandListSize(), steps, mostFaults,
+        progressed ? "" : "  FAILED");
+    allocator->deallocate(process);
+    delete allocator;
+}
+
+// Maximal free runs of the bitmap model as (start, size), in address order
+static std::vector<std::pair<int, int>> modelBlocks(const std::vector<bool>& used) {
+    std::vector<std::pair<int, int>> blocks;
+    int size = int(used.size());
+    for (int i = 0; i < size; i++) {
+        if (used[i]) continue;
+        int start = i;
+        while (i < size && !used[i]) i++;
+        blocks.push_back({ start, i - start });
+    }
+    return blocks;
+}
+
+// Where the policy should place size bytes, or -1: first fit takes the
+// lowest fitting block, best fit the smallest (lowest on a tie), worst fit
+// the largest (highest on a tie); all carve from the front of the block.
+static int modelAllocate(const std::vector<std::pair<int, int>>& blocks, FreeList::Policy policy, int size) {
+    int chosen = -1;
+    for (size_t i = 0; i < blocks.size(); i++) {
+        if (blocks[i].second < size) continue;
+        if (chosen == -1) {
+            chosen = int(i);
+            if (policy == FreeList::FIRST_FIT) break;
+        }
+        else if (policy == FreeList::BEST_FIT && blocks[i].second < blocks[chosen].second) {
+            chosen = int(i);
+        }
+        else if (policy == FreeList::WORST_FIT && blocks[i].second >= blocks[chosen].second) {
+            chosen = int(i);
+        }
+    }
+    return chosen == -1 ? -1 : blocks[chosen].first;
+}
+
+// FreeList against a brute-force bitmap of the same space: every op's
+// result, and the free blocks, free memory and largest block after it.
+static void checkFreeList(std::string policyName) {
+    FreeList::Policy policy = FreeList::parsePolicy(policyName);
+    FreeList list(MODEL_SIZE, policy);
+    std::vector<bool> used(MODEL_SIZE, false);
+    // (start, size) of every live allocation
+    std::vector<std::pair<int, int>> live;
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> sizeDistr(1, 96);
+
+    int failedAt = -1;
+    for (int op = 0; op < MODEL_OPS && failedAt == -1; op++) {
+        std::vector<std::pair<int, int>> before = modelBlocks(used);
+        if (live.empty() || generator() % 2 == 0) {
+            int size = sizeDistr(generator);
+            int expected = modelAllocate(before, policy, size);
+            int start = list.allocate(size);
+            if (start != expected) {
+                failedAt = op;
+                break;
+            }
+            if (start != -1) {
+                std::fill(used.begin() + start, used.begin() + start + size, true);
+                live.push_back({ start, size });
+            }
+        }
+        else {
+            size_t victim = generator() % live.size();
+            list.release(live[victim].first, live[victim].second);
+            std::fill(used.begin() + live[victim].first, used.begin() + live[victim].first + live[victim].second, false);
+            live[victim] = live.back();
+            live.pop_back();
+        }
+
+        std::vector<std::pair<int, int>> after = modelBlocks(used);
+        int freeMemory = 0;
+        int largest = 0;
+        for (size_t i = 0; i < after.size(); i++) {
+            freeMemory += after[i].second;
+            largest = std::max(largest, after[i].second);
+        }
+        if (list.getBlocks() != after || list.getFreeMemory() != freeMemory
+            || list.getLargestBlock() != largest || list.getBlockCount() != int(after.size())) {
+            failedAt = op;
+        }
+    }
+    if (failedAt == -1) {
+        std::printf("  free list %s against a bitmap model: %d ops agreed\n", policyName.c_str(), MODEL_OPS);
+    }
+    else {
+        std::printf("  free list %s against a bitmap model: disagreed at op %d  FAILED\n", policyName.c_str(), failedAt);
+    }
+}
+
+void AllocatorBench::run() {
+    PrintCommand::setMsDelay(0);
+    Bench::printHeader("allocators (admit, touch and retire, single thread)");
+
+    // 64-1024 bytes rounded up to a power of two; 16 of them average about
+    // half of memory
+    Pool uniform = makePool("alloc_", POOL_SIZE, 64, 1024);
+    // Three small processes for every large one, sized to keep memory about
+    // 90% committed so every allocation has to find room between the others
+    Pool small = makePool("alloc_s", POOL_SIZE * 3 / 4, 64, 128);
+    Pool large = makePool("alloc_l", POOL_SIZE / 4, 1024, 2048);
+    Pool mixed;
+    for (int i = 0; i < POOL_SIZE / 4; i++) {
+        mixed.push_back(large[i]);
+        for (int s = 0; s < 3; s++) {
+            mixed.push_back(small[i * 3 + s]);
+        }
+    }
+
+    const char* fitPolicies[] = { "first", "best", "worst" };
+    for (const char* policy : fitPolicies) {
+        IAllocator* allocator = makeAllocator("flat", policy);
+        runCase(std::string("flat ") + policy + " churn", allocator, uniform, 16, false);
+        runCase(std::string("flat ") + policy + " mix", allocator, mixed, 24, true);
+        delete allocator;
+    }
+    for (const char* policy : fitPolicies) {
+        checkFreeList(policy);
+    }
+    IAllocator* buddy = makeAllocator("buddy", "");
+    runCase("buddy churn", buddy, uniform, 16, false);
+    runCase("buddy mix", buddy, mixed, 24, true);
+    delete buddy;
+
+    // Paging sizes every process the same, so there is no mix: 256 bytes in
+    // 4 pages of 64, and enough residents to overcommit memory twice over
+    Process::setRequiredMemory(256, 256);
+    Process::setRequiredPages(4, 4);
+    Pool paged = makePool("alloc_p", POOL_SIZE, 256, 256);
+    const char* replacements[] = { "fifo", "lru", "clock", "second-chance" };
+    for (const char* replacement : replacements) {
+        IAllocator* allocator = makeAllocator("paging", replacement);
+        runCase(std::string("paging ") + replacement + " churn", allocator, paged, 128, false);
+        delete allocator;
+    }
+    for (const char* replacement : replacements) {
+        checkProgress(replacement);
+    }
+    Process::resetRequiredMemory();
+}
@@ -0,0 +1,16 @@
+#pragma once
+#ifndef ALLOCATORBENCH_H
+#define ALLOCATORBENCH_H
+
+
+// Single-threaded allocator throughput without the memory manager's lock:
+// steady allocate/free churn, and a mix of small and large processes that
+// keeps memory nearly full so fit policies, splitting and eviction matter.
+// Also checks the free list against a bitmap model, and that paging makes
+// progress on two frames.
+class AllocatorBench {
+public:
+    static void run();
+};
+
+#endif // !ALLOCATORBENCH_H
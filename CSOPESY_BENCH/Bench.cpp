@@ -0,0 +1,44 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EventEngine.h"
+
+
+long long Bench::nanosSince(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+// Nearest-rank percentile; sorts samples in place.
+double Bench::percentile(std::vector<long long>& samples, double p) {
+    if (samples.empty()) return 0;
+    std::sort(samples.begin(), samples.end());
+    size_t rank = size_t(p / 100.0 * (samples.size() - 1) + 0.5);
+    return double(samples[std::min(rank, samples.size() - 1)]);
+}
+
+void Bench::printHeader(std::string title) {
+    std::printf("\n== %s ==\n", title.c_str());
+    std::printf("%-36s %14s %10s %10s %10s\n", "case", "ops/sec", "p50 ns", "p99 ns", "max ns");
+}
+
+void Bench::report(std::string name, long long ops, long long totalNanos, std::vector<long long>& latencies) {
+    double opsPerSec = totalNanos > 0 ? ops * 1e9 / totalNanos : 0;
+    double p50 = Bench::percentile(latencies, 50);
+    double p99 = Bench::percentile(latencies, 99);
+    double max = latencies.empty() ? 0 : double(latencies.back());
+    std::printf("%-36s %14.0f %10.0f %10.0f %10.0f\n", name.c_str(), opsPerSec, p50, p99, max);
+}
+
+void Bench::drainEngine() {
+    std::atomic<bool> reached{ false };
+    EventEngine::get()->post([&reached]() { reached = true; });
+    while (!reached) {
+        std::this_thread::yield();
+    }
+}
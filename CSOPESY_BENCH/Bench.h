@@ -0,0 +1,25 @@
+#pragma once
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+
+// Shared timing and reporting helpers for the benchmark binary.
+class Bench {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static long long nanosSince(Clock::time_point start);
+    static double percentile(std::vector<long long>& samples, double p);
+
+    static void printHeader(std::string title);
+    static void report(std::string name, long long ops, long long totalNanos, std::vector<long long>& latencies);
+    // Blocks until the event engine has run everything queued so far, e.g.
+    // before destroying a scheduler its callbacks still point at
+    static void drainEngine();
+};
+
+#endif // !BENCH_H
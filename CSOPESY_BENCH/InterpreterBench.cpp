@@ -0,0 +1,53 @@
+#include "InterpreterBench.h"
+#include "Bench.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "PrintCommand.h"
+#include "Process.h"
+
+// Steps are timed in blocks; timing every single step would cost more than
+// the step itself.
+static const int STEPS_PER_SAMPLE = 1024;
+
+
+static void runCase(int processes, int instructions) {
+    std::uniform_int_distribution<int> commandDistr(instructions, instructions);
+    std::uniform_int_distribution<int> memoryDistr(4096, 4096);
+    std::uniform_int_distribution<int> pageDistr(1, 1);
+
+    std::vector<std::shared_ptr<Process>> list;
+    for (int i = 0; i < processes; i++) {
+        list.push_back(std::make_shared<Process>("bench_" + std::to_string(i), commandDistr, memoryDistr, pageDistr));
+    }
+
+    std::vector<long long> latencies;
+    long long retired = 0;
+    Bench::Clock::time_point begin = Bench::Clock::now();
+    for (size_t i = 0; i < list.size(); i++) {
+        Process* process = list[i].get();
+        while (!process->hasFinished()) {
+            Bench::Clock::time_point t = Bench::Clock::now();
+            for (int step = 0; step < STEPS_PER_SAMPLE && !process->hasFinished(); step++) {
+                process->execute();
+            }
+            latencies.push_back(Bench::nanosSince(t) / STEPS_PER_SAMPLE);
+        }
+        retired += process->getCommandCounter();
+    }
+    long long total = Bench::nanosSince(begin);
+
+    Bench::report(std::to_string(processes) + " procs x " + std::to_string(instructions) + " instructions",
+        retired, total, latencies);
+}
+
+void InterpreterBench::run() {
+    PrintCommand::setMsDelay(0);
+    Bench::printHeader("interpreter (instructions retired, ns per instruction)");
+    runCase(100, 1000);
+    runCase(100, 10000);
+    runCase(10, 100000);
+}
@@ -0,0 +1,13 @@
+#pragma once
+#ifndef INTERPRETERBENCH_H
+#define INTERPRETERBENCH_H
+
+
+// Raw instructions-per-second of Process::execute on generated programs,
+// with no scheduler or event engine in the way and PRINT's delay off.
+class InterpreterBench {
+public:
+    static void run();
+};
+
+#endif // !INTERPRETERBENCH_H
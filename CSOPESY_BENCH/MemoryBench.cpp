@@ -0,0 +1,146 @@
+#include "MemoryBench.h"
+#include "Bench.h"
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MemoryManager.h"
+#include "PrintCommand.h"
+#include "Process.h"
+
+static const int MAX_MEMORY = 16384;
+static const int PROCESSES_PER_THREAD = 2000;
+static const int ACCESSES_PER_PROCESS = 16;
+
+
+// A report is consistent if the usage line matches the processes listed
+// under it. Every allocator lists "<name> <size>..." per resident process.
+// For paging the usage line counts used frames in the frame table while
+// each listed size comes from that process's page table, so a frame lost or
+// double-counted between the two shows up here.
+static bool isConsistent(const std::string& report) {
+    std::istringstream lines(report);
+    std::string line;
+    long long usage = -1;
+    long long listed = 0;
+    while (std::getline(lines, line)) {
+        if (line.rfind("Memory Usage: ", 0) == 0) {
+            usage = std::stoll(line.substr(14));
+        }
+        else if (line.rfind("mem_", 0) == 0) {
+            std::istringstream fields(line);
+            std::string name;
+            long long size = 0;
+            fields >> name >> size;
+            listed += size;
+        }
+    }
+    return usage == listed;
+}
+
+static void runCase(std::string allocator, int threads) {
+    std::uniform_int_distribution<int> commandDistr(100, 100);
+    std::uniform_int_distribution<int> memoryDistr(64, 1024);
+    std::uniform_int_distribution<int> pageDistr(1, 1);
+
+    // Processes are made up front so construction stays out of the timing
+    std::vector<std::vector<std::shared_ptr<Process>>> work(threads);
+    for (int t = 0; t < threads; t++) {
+        for (int i = 0; i < PROCESSES_PER_THREAD; i++) {
+            work[t].push_back(std::make_shared<Process>("mem_" + std::to_string(t) + "_" + std::to_string(i),
+                commandDistr, memoryDistr, pageDistr));
+        }
+    }
+    MemoryManager memory(MAX_MEMORY, 4, 4, allocator, "first", "lru");
+
+    std::atomic<bool> start{ false };
+    std::atomic<bool> done{ false };
+    std::vector<std::vector<long long>> latencies(threads);
+
+    std::vector<long long> reportLatencies;
+    int reports = 0;
+    int torn = 0;
+    std::thread reader([&]() {
+        while (!start) {}
+        while (!done) {
+            std::ostringstream report;
+            Bench::Clock::time_point t = Bench::Clock::now();
+            memory.printProcesses(report);
+            reportLatencies.push_back(Bench::nanosSince(t));
+            reports++;
+            if (!isConsistent(report.str())) {
+                torn++;
+            }
+        }
+        });
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            latencies[t].reserve(PROCESSES_PER_THREAD);
+            while (!start) {}
+            for (size_t i = 0; i < work[t].size(); i++) {
+                std::shared_ptr<Process>& process = work[t][i];
+                Bench::Clock::time_point begin = Bench::Clock::now();
+                if (memory.allocate(process)) {
+                    for (int a = 0; a < ACCESSES_PER_PROCESS; a++) {
+                        if (memory.access(process)) {
+                            process->execute();
+                        }
+                    }
+                    memory.deallocate(process);
+                }
+                latencies[t].push_back(Bench::nanosSince(begin));
+            }
+            });
+    }
+
+    Bench::Clock::time_point begin = Bench::Clock::now();
+    start = true;
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+    long long total = Bench::nanosSince(begin);
+    done = true;
+    reader.join();
+
+    std::vector<long long> all;
+    for (int t = 0; t < threads; t++) {
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+    }
+    std::string name = allocator + " x" + std::to_string(threads);
+    Bench::report(name, (long long)threads * PROCESSES_PER_THREAD, total, all);
+    Bench::report(name + " status reports", reports, total, reportLatencies);
+
+    std::ostringstream final;
+    memory.printProcesses(final);
+    bool empty = final.str().rfind("Memory Usage: 0 /", 0) == 0;
+    if (torn > 0 || !empty) {
+        std::printf("  FAILED: %d of %d reports inconsistent, %s at the end\n",
+            torn, reports, empty ? "empty" : "not empty");
+    }
+}
+
+void MemoryBench::run() {
+    PrintCommand::setMsDelay(0);
+    Bench::printHeader("memory manager (allocate/access/free cycles under contention)");
+    int threadCounts[] = { 1, 2, 4, 8 };
+    // Paging goes last: it fixes every process to the same size until reset
+    const char* allocators[] = { "flat", "buddy" };
+    for (const char* allocator : allocators) {
+        for (int threads : threadCounts) {
+            runCase(allocator, threads);
+        }
+    }
+    Process::setRequiredMemory(256, 256);
+    for (int threads : threadCounts) {
+        runCase("paging", threads);
+    }
+    Process::resetRequiredMemory();
+}
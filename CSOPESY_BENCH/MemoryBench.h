@@ -0,0 +1,14 @@
+#pragma once
+#ifndef MEMORYBENCH_H
+#define MEMORYBENCH_H
+
+
+// Stress test for MemoryManager: worker threads allocate, touch and free
+// processes while a reader keeps taking status reports and checks that
+// none of them shows a half-applied change.
+class MemoryBench {
+public:
+    static void run();
+};
+
+#endif // !MEMORYBENCH_H
@@ -0,0 +1,99 @@
+#include "ProcessBench.h"
+#include "Bench.h"
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EventEngine.h"
+#include "Process.h"
+#include "Scheduler.h"
+
+static const int ADMISSIONS = 100000;
+static const int CPU_COUNT = 4;
+
+
+static std::vector<std::shared_ptr<Process>> construct(int count, int instructions) {
+    std::uniform_int_distribution<int> commandDistr(instructions, instructions);
+    std::uniform_int_distribution<int> memoryDistr(64, 4096);
+    std::uniform_int_distribution<int> pageDistr(1, 1);
+
+    std::vector<std::shared_ptr<Process>> processes;
+    processes.reserve(count);
+    std::vector<long long> latencies;
+    latencies.reserve(count);
+    Bench::Clock::time_point begin = Bench::Clock::now();
+    for (int i = 0; i < count; i++) {
+        Bench::Clock::time_point t = Bench::Clock::now();
+        processes.push_back(std::make_shared<Process>("process_" + std::to_string(i), commandDistr, memoryDistr, pageDistr));
+        latencies.push_back(Bench::nanosSince(t));
+    }
+    long long total = Bench::nanosSince(begin);
+    Bench::report("construct " + std::to_string(count) + " x " + std::to_string(instructions) + " instructions",
+        count, total, latencies);
+    return processes;
+}
+
+// The scheduler is left stopped, so admitted processes stay queued and the
+// only work on the engine thread is admission itself.
+static void admit(std::vector<std::shared_ptr<Process>>& processes, int producers) {
+    Scheduler::initialize(CPU_COUNT, 1, 1, 1, 64, 64, 16384, 1, 1, "flat", "first", "lru");
+    Scheduler* scheduler = Scheduler::get();
+
+    std::atomic<bool> start{ false };
+    std::vector<std::vector<long long>> latencies(producers);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            latencies[p].reserve(processes.size() / producers + 1);
+            while (!start) {}
+            for (size_t i = p; i < processes.size(); i += producers) {
+                Bench::Clock::time_point t = Bench::Clock::now();
+                scheduler->addProcess(processes[i]);
+                latencies[p].push_back(Bench::nanosSince(t));
+            }
+            });
+    }
+
+    Bench::Clock::time_point begin = Bench::Clock::now();
+    start = true;
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+    for (size_t i = 0; i < processes.size(); i++) {
+        while (scheduler->getProcess(processes[i]->getID()) == nullptr) {
+            std::this_thread::yield();
+        }
+    }
+    long long total = Bench::nanosSince(begin);
+
+    std::vector<long long> all;
+    for (int p = 0; p < producers; p++) {
+        all.insert(all.end(), latencies[p].begin(), latencies[p].end());
+    }
+    Bench::report("admit " + std::to_string(processes.size() / 1000) + "k x" + std::to_string(producers),
+        (long long)processes.size(), total, all);
+
+    // The last admission also queued a dispatch pass that still points here
+    Bench::drainEngine();
+    scheduler->destroy();
+}
+
+void ProcessBench::run() {
+    Bench::printHeader("processes (construction, and admission until queued)");
+    construct(10000, 100);
+    construct(10000, 1000);
+    construct(1000, 10000);
+
+    EventEngine::initialize(false, 0);
+    EventEngine::get()->start();
+    std::vector<std::shared_ptr<Process>> processes = construct(ADMISSIONS, 100);
+    int producerCounts[] = { 1, 2, 4, 8 };
+    for (int producers : producerCounts) {
+        admit(processes, producers);
+    }
+    EventEngine::destroy();
+}
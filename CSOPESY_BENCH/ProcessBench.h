@@ -0,0 +1,14 @@
+#pragma once
+#ifndef PROCESSBENCH_H
+#define PROCESSBENCH_H
+
+
+// Cost of constructing processes (PID, RNG and program generation), and of
+// admitting 100k of them into a live scheduler from several threads, up to
+// the point where every one is on a run queue.
+class ProcessBench {
+public:
+    static void run();
+};
+
+#endif // !PROCESSBENCH_H
@@ -0,0 +1,126 @@
+#include "QueueBench.h"
+#include "Bench.h"
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Process.h"
+#include "RunQueue.h"
+
+static const int QUEUE_LENGTH = 10000;
+static const int REQUEUE_LENGTH = 1000;
+static const int REQUEUES = 1000000;
+static const int MLFQ_LEVELS = 4;
+
+
+static void setUp(RunQueue& queue, RunQueue::Order order) {
+    queue.setOrder(order);
+    if (order == RunQueue::MULTILEVEL) {
+        queue.setLevels(MLFQ_LEVELS);
+    }
+}
+
+static void fillAndDrain(std::string name, RunQueue::Order order, std::vector<std::shared_ptr<Process>>& processes) {
+    RunQueue queue;
+    setUp(queue, order);
+    std::vector<long long> latencies;
+    latencies.reserve(processes.size());
+
+    Bench::Clock::time_point begin = Bench::Clock::now();
+    for (size_t i = 0; i < processes.size(); i++) {
+        Bench::Clock::time_point t = Bench::Clock::now();
+        queue.push(processes[i]);
+        latencies.push_back(Bench::nanosSince(t));
+    }
+    long long total = Bench::nanosSince(begin);
+    Bench::report(name + " push", (long long)processes.size(), total, latencies);
+
+    latencies.clear();
+    begin = Bench::Clock::now();
+    while (true) {
+        Bench::Clock::time_point t = Bench::Clock::now();
+        std::shared_ptr<Process> process = queue.front();
+        if (process == nullptr) break;
+        queue.pop();
+        latencies.push_back(Bench::nanosSince(t));
+    }
+    total = Bench::nanosSince(begin);
+    Bench::report(name + " front+pop", (long long)latencies.size(), total, latencies);
+}
+
+// A quantum expiry: the owner takes the front process and puts it back, with
+// REQUEUE_LENGTH processes queued. With a thief, another thread keeps stealing
+// from the far end and pushing back, as an idle neighbour would.
+static void requeue(std::string name, RunQueue::Order order, std::vector<std::shared_ptr<Process>>& processes, bool thief) {
+    RunQueue queue;
+    setUp(queue, order);
+    for (int i = 0; i < REQUEUE_LENGTH; i++) {
+        queue.push(processes[i]);
+    }
+
+    std::atomic<bool> done{ false };
+    std::thread stealer;
+    if (thief) {
+        stealer = std::thread([&]() {
+            while (!done) {
+                std::shared_ptr<Process> process = queue.steal();
+                if (process != nullptr) {
+                    queue.push(process);
+                }
+            }
+            });
+    }
+
+    std::vector<long long> latencies;
+    latencies.reserve(REQUEUES);
+    Bench::Clock::time_point begin = Bench::Clock::now();
+    for (int i = 0; i < REQUEUES; i++) {
+        Bench::Clock::time_point t = Bench::Clock::now();
+        std::shared_ptr<Process> process = queue.front();
+        if (process != nullptr) {
+            queue.pop();
+            queue.push(process);
+        }
+        latencies.push_back(Bench::nanosSince(t));
+    }
+    long long total = Bench::nanosSince(begin);
+    done = true;
+    if (stealer.joinable()) {
+        stealer.join();
+    }
+    Bench::report(name + (thief ? " requeue + thief" : " requeue"), REQUEUES, total, latencies);
+}
+
+void QueueBench::run() {
+    Bench::printHeader("run queues (per-core ready queue operations)");
+
+    // Varied bursts so the shortest-first heap actually reorders, and spread
+    // over the levels the way demotion would leave them
+    std::uniform_int_distribution<int> commandDistr(1, 1000);
+    std::uniform_int_distribution<int> memoryDistr(64, 64);
+    std::uniform_int_distribution<int> pageDistr(1, 1);
+    std::vector<std::shared_ptr<Process>> processes;
+    for (int i = 0; i < QUEUE_LENGTH; i++) {
+        processes.push_back(std::make_shared<Process>("queue_" + std::to_string(i), commandDistr, memoryDistr, pageDistr));
+        processes.back()->setPriorityLevel(i % MLFQ_LEVELS);
+    }
+
+    struct Case {
+        const char* name;
+        RunQueue::Order order;
+    };
+    Case cases[] = {
+        { "fifo", RunQueue::FIFO },
+        { "shortest-first", RunQueue::SHORTEST_FIRST },
+        { "multilevel", RunQueue::MULTILEVEL },
+    };
+    for (const Case& c : cases) {
+        fillAndDrain(c.name, c.order, processes);
+        requeue(c.name, c.order, processes, false);
+        requeue(c.name, c.order, processes, true);
+    }
+}
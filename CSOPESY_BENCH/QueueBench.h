@@ -0,0 +1,14 @@
+#pragma once
+#ifndef QUEUEBENCH_H
+#define QUEUEBENCH_H
+
+
+// Per-core ready queue operations in each order the schedulers use: FIFO
+// (FCFS, RR), shortest remaining burst (SJF) and multilevel (MLFQ), alone
+// and with a neighbour stealing from the far end.
+class QueueBench {
+public:
+    static void run();
+};
+
+#endif // !QUEUEBENCH_H
@@ -0,0 +1,119 @@
+#include "TickBench.h"
+#include "Bench.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EventEngine.h"
+#include "LogWriter.h"
+#include "PrintCommand.h"
+#include "Process.h"
+#include "Scheduler.h"
+
+static const int ROUNDS = 10;
+static const int PROCESSES_PER_ROUND = 32;
+static const int INSTRUCTIONS = 10000;
+
+// Where the poller's reads go, so they are not optimised away
+static std::atomic<long long> observed{ 0 };
+
+
+static void runCase(int cpus, int perTick, bool polled, bool logged = false) {
+    std::uniform_int_distribution<int> commandDistr(INSTRUCTIONS, INSTRUCTIONS);
+    std::uniform_int_distribution<int> memoryDistr(64, 64);
+    std::uniform_int_distribution<int> pageDistr(1, 1);
+
+    Scheduler::initialize(cpus, 1, 1, 1, 64, 64, 65536, 1, 1, "flat", "first", "lru");
+    Scheduler* scheduler = Scheduler::get();
+    scheduler->startFCFS();
+    scheduler->setInstructionsPerTick(perTick);
+    if (logged) {
+        LogWriter::initialize("output");
+        LogWriter::get()->start();
+    }
+
+    std::vector<std::shared_ptr<Process>> all;
+    std::atomic<int> published{ 0 };
+    std::atomic<bool> done{ false };
+    std::thread poller;
+    if (polled) {
+        all.resize(ROUNDS * PROCESSES_PER_ROUND);
+        poller = std::thread([&]() {
+            long long sink = 0;
+            while (!done) {
+                int count = published;
+                for (int i = 0; i < count; i++) {
+                    Process* process = all[i].get();
+                    sink += process->getName().size() + process->getCommandCounter()
+                        + process->getCommandListSize() + process->hasFinished();
+                }
+            }
+            observed += sink;
+            });
+    }
+
+    std::vector<long long> latencies;
+    long long ticks = 0;
+    Bench::Clock::time_point begin = Bench::Clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        Bench::Clock::time_point t = Bench::Clock::now();
+        for (int i = 0; i < PROCESSES_PER_ROUND; i++) {
+            std::shared_ptr<Process> process = std::make_shared<Process>("tick_" + std::to_string(i),
+                commandDistr, memoryDistr, pageDistr);
+            if (polled) {
+                all[round * PROCESSES_PER_ROUND + i] = process;
+                published++;
+            }
+            scheduler->addProcess(process);
+        }
+        int target = (round + 1) * PROCESSES_PER_ROUND;
+        while (scheduler->getFinishedCount() < target) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        latencies.push_back(Bench::nanosSince(t) / (PROCESSES_PER_ROUND * (long long)INSTRUCTIONS));
+        ticks += PROCESSES_PER_ROUND * (long long)INSTRUCTIONS;
+    }
+    long long total = Bench::nanosSince(begin);
+    if (logged) {
+        LogWriter::get()->stop();
+        LogWriter::destroy();
+    }
+
+    done = true;
+    if (poller.joinable()) {
+        poller.join();
+    }
+    std::string name = std::to_string(cpus) + " cpu fcfs";
+    if (perTick > 1) {
+        name += " x" + std::to_string(perTick) + "/tick";
+    }
+    if (polled) {
+        name += " + status poller";
+    }
+    Bench::report(name + (logged ? " + PRINT logging" : ""), ticks, total, latencies);
+
+    scheduler->stop();
+    Bench::drainEngine();
+    scheduler->destroy();
+}
+
+void TickBench::run() {
+    PrintCommand::setMsDelay(0);
+    Bench::printHeader("ticks (instructions retired through CPU::execute, ns per instruction)");
+
+    EventEngine::initialize(false, 0);
+    EventEngine::get()->start();
+    runCase(1, 1, false);
+    runCase(4, 1, false);
+    runCase(4, 1, true);
+    runCase(4, 1, false, true);
+    runCase(4, 16, false);
+    runCase(4, 256, false);
+    runCase(4, 256, true);
+    EventEngine::destroy();
+}
@@ -0,0 +1,18 @@
+#pragma once
+#ifndef TICKBENCH_H
+#define TICKBENCH_H
+
+
+// Cost of the CPU tick path end to end: processes run to completion on a
+// live FCFS scheduler in fast mode, so each op is one instruction retired
+// through CPU::execute, the memory manager and the event engine. Run with
+// one instruction per tick and with batches, and with a thread polling
+// every process's progress the way screen -ls and process-smi do, and with
+// PRINT output going to the log writer as it does in the simulator.
+// Latencies are ns per instruction for each round of processes.
+class TickBench {
+public:
+    static void run();
+};
+
+#endif // !TICKBENCH_H
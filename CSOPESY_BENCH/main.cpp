@@ -0,0 +1,41 @@
+#include "AdmissionBench.h"
+#include "AllocatorBench.h"
+#include "InterpreterBench.h"
+#include "MemoryBench.h"
+#include "ProcessBench.h"
+#include "TickBench.h"
+#include "QueueBench.h"
+
+#include <iostream>
+#include <string>
+
+
+// Usage: CSOPESY_BENCH [suite]   (no argument runs everything)
+int main(int argc, char* argv[]) {
+    std::string only = argc > 1 ? argv[1] : "";
+
+    if (only == "" || only == "admission") {
+        AdmissionBench::run();
+    }
+    if (only == "" || only == "interpreter") {
+        InterpreterBench::run();
+    }
+    if (only == "" || only == "queue") {
+        QueueBench::run();
+    }
+    if (only == "" || only == "process") {
+        ProcessBench::run();
+    }
+    if (only == "" || only == "tick") {
+        TickBench::run();
+    }
+    if (only == "" || only == "allocator") {
+        AllocatorBench::run();
+    }
+    if (only == "" || only == "memory") {
+        MemoryBench::run();
+    }
+
+    std::cout << std::endl;
+    return 0;
+}
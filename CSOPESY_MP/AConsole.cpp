@@ -1,10 +1,10 @@
 #include "AConsole.h"
+#include "Platform.h"
 
 #include <iostream>
 #include <memory>
 #include <string>
 #include <thread>
-#include <windows.h>
 #include <tuple>
 
 AConsole::AConsole(std::string name) {
@@ -32,9 +32,7 @@ void AConsole::draw() {
 }
 
 void AConsole::SetCursorPosition(short row, short col) {
-    HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
-    COORD coord = { col, row };
-    SetConsoleCursorPosition(handle, coord);
+    Platform::setCursorPosition(row, col);
 }
 
 void AConsole::DrawHorizontalLine(short row, short col, short length, bool two) {
@@ -87,12 +85,5 @@ void AConsole::DrawBox(short topRow, short leftCol, short width, short height, b
 }
 
 std::tuple<short, short> AConsole::getWindowSize() {
-    CONSOLE_SCREEN_BUFFER_INFO csbi;
-    short width, height;
-
-    GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
-    width = csbi.srWindow.Right - csbi.srWindow.Left + 1;
-    height = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
-
-    return std::make_tuple(width, height);
+    return Platform::getWindowSize();
 }
\ No newline at end of file
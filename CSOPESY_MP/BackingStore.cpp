@@ -0,0 +1,62 @@
+#include "BackingStore.h"
+
+#include <cstring>
+#include <iostream>
+
+
+BackingStore::BackingStore(std::string filename) {
+    this->_file.open(filename, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!this->_file.is_open()) {
+        std::cerr << "Failed to open " << filename << std::endl;
+    }
+}
+
+void BackingStore::swapOut(std::shared_ptr<Process> process) {
+    int pid = process->getID();
+    if (this->_slots.find(pid) != this->_slots.end()) {
+        return;
+    }
+
+    int slot;
+    if (!this->_freeSlots.empty()) {
+        slot = this->_freeSlots.back();
+        this->_freeSlots.pop_back();
+    }
+    else {
+        slot = this->_nextSlot++;
+    }
+
+    Record record = {};
+    // Longer names are truncated; the index, not the file, is authoritative
+    std::strncpy(record.name, process->getName().c_str(), NAME_LENGTH - 1);
+    record.pid = pid;
+    record.commandCounter = process->getCommandCounter();
+    record.requiredMemory = process->getRequiredMemory();
+    record.inUse = 1;
+    this->writeRecord(slot, record);
+    this->_slots[pid] = slot;
+}
+
+bool BackingStore::swapIn(std::shared_ptr<Process> process) {
+    auto entry = this->_slots.find(process->getID());
+    if (entry == this->_slots.end()) {
+        return false;
+    }
+
+    Record record = {};
+    this->writeRecord(entry->second, record);
+    this->_freeSlots.push_back(entry->second);
+    this->_slots.erase(entry);
+    return true;
+}
+
+bool BackingStore::isSwappedOut(int pid) const {
+    return this->_slots.find(pid) != this->_slots.end();
+}
+
+void BackingStore::writeRecord(int slot, const Record& record) {
+    if (!this->_file.is_open()) return;
+    this->_file.seekp(std::streamoff(slot) * sizeof(Record));
+    this->_file.write(reinterpret_cast<const char*>(&record), sizeof(Record));
+    this->_file.flush();
+}
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef BACKINGSTORE_H
+#define BACKINGSTORE_H
+
+#include "Process.h"
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+// Swap file of fixed-size binary records, one per swapped-out process. An
+// in-memory index maps each process to its record slot, so checking whether
+// a process is swapped out touches no file at all, and swapping in or out is
+// a single seek plus a single write.
+class BackingStore {
+public:
+    BackingStore(std::string filename);
+    ~BackingStore() = default;
+
+    void swapOut(std::shared_ptr<Process> process);
+    // Drops the process's record; returns false (without any I/O) if it was
+    // not swapped out
+    bool swapIn(std::shared_ptr<Process> process);
+
+    bool isSwappedOut(int pid) const;
+    size_t size() const { return this->_slots.size(); };
+
+private:
+    static const int NAME_LENGTH = 32;
+
+    struct Record {
+        char name[NAME_LENGTH];
+        int32_t pid;
+        int32_t commandCounter;
+        int32_t requiredMemory;
+        int32_t inUse;
+    };
+
+    void writeRecord(int slot, const Record& record);
+
+    std::fstream _file;
+    // PID > record slot
+    std::unordered_map<int, int> _slots;
+    std::vector<int> _freeSlots;
+    int _nextSlot = 0;
+};
+
+#endif // !BACKINGSTORE_H
@@ -0,0 +1,201 @@
+#include "BatchRunner.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Config.h"
+#include "EventEngine.h"
+#include "MemoryManager.h"
+#include "Random.h"
+#include "Scheduler.h"
+
+
+static std::string jsonString(const std::string& value) {
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+static std::string csvField(const std::string& value) {
+    if (value.find_first_of(",\"\n") == std::string::npos) return value;
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+int BatchRunner::run(int argc, char* argv[]) {
+    Options options;
+    if (!BatchRunner::parse(argc, argv, options)) {
+        BatchRunner::printUsage(std::cerr);
+        return 2;
+    }
+
+    Config config = Config();
+    if (!config.initialize(options.config)) {
+        return 1;
+    }
+    // Wall-clock pacing would only slow the run down and make arrivals depend
+    // on host timing, and the realtime arrival thread would outlive the engine
+    config.forceFastMode();
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    if (!Scheduler::startSimulation(config)) {
+        return 1;
+    }
+    Scheduler* sched = Scheduler::get();
+    sched->schedulerTest(options.processes);
+    EventEngine::get()->post([options]() { BatchRunner::watch(options); });
+    while (EventEngine::get()->isRunning()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    Scheduler::stopSimulation();
+
+    long long ticks = EventEngine::get()->getTick();
+    int finished = sched->getFinishedCount();
+    int totalTicks = sched->getTotalTicks();
+    int inactiveTicks = sched->getInactiveTicks();
+    int pagedIn = 0;
+    int pagedOut = 0;
+    sched->getMemoryManager()->getPageCounts(pagedIn, pagedOut);
+    Scheduler::Latencies latencies = sched->getLatencies();
+
+    // (name, value, quoted in JSON)
+    std::vector<std::pair<std::string, std::pair<std::string, bool>>> fields;
+    auto text = [&fields](std::string name, std::string value) {
+        fields.push_back({ name, { value, true } });
+        };
+    auto number = [&fields](std::string name, double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+        fields.push_back({ name, { buffer, false } });
+        };
+    text("config", options.config);
+    fields.push_back({ "seed", { std::to_string(Random::getSeed()), false } });
+    text("scheduler", config.getScheduler());
+    text("allocator", config.getAllocator());
+    number("cpus", config.getNumCpu());
+    number("instructions_per_tick", config.getInstructionsPerTick());
+    number("processes_finished", finished);
+    number("ticks", double(ticks));
+    number("wall_seconds", wallSeconds);
+    number("throughput_per_1k_ticks", ticks > 0 ? finished * 1000.0 / ticks : 0);
+    number("throughput_per_second", wallSeconds > 0 ? finished / wallSeconds : 0);
+    number("cpu_utilisation", totalTicks > 0 ? double(totalTicks - inactiveTicks) / totalTicks : 0);
+    number("active_cpu_ticks", totalTicks - inactiveTicks);
+    number("idle_cpu_ticks", inactiveTicks);
+    number("paged_in", pagedIn);
+    number("paged_out", pagedOut);
+    const char* names[] = { "waiting", "turnaround", "response" };
+    std::vector<long long>* samples[] = { &latencies.waiting, &latencies.turnaround, &latencies.response };
+    for (int i = 0; i < 3; i++) {
+        std::string name = names[i];
+        number(name + "_mean", Scheduler::mean(*samples[i]));
+        number(name + "_p50", double(Scheduler::percentile(*samples[i], 50)));
+        number(name + "_p90", double(Scheduler::percentile(*samples[i], 90)));
+        number(name + "_p99", double(Scheduler::percentile(*samples[i], 99)));
+    }
+    number("context_switches_per_process",
+        latencies.waiting.empty() ? 0 : double(latencies.contextSwitches) / latencies.waiting.size());
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output, std::ios::out | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << options.output << " failed to open" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+    if (options.format == "csv") {
+        for (size_t i = 0; i < fields.size(); i++) {
+            out << (i > 0 ? "," : "") << fields[i].first;
+        }
+        out << "\n";
+        for (size_t i = 0; i < fields.size(); i++) {
+            const std::pair<std::string, bool>& value = fields[i].second;
+            out << (i > 0 ? "," : "") << (value.second ? csvField(value.first) : value.first);
+        }
+        out << std::endl;
+    }
+    else {
+        out << "{";
+        for (size_t i = 0; i < fields.size(); i++) {
+            const std::pair<std::string, bool>& value = fields[i].second;
+            out << (i > 0 ? ",\n  " : "\n  ") << "\"" << fields[i].first << "\": ";
+            out << (value.second ? jsonString(value.first) : value.first);
+        }
+        out << "\n}" << std::endl;
+    }
+    return 0;
+}
+
+bool BatchRunner::parse(int argc, char* argv[], Options& options) {
+    bool batch = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--batch") {
+            batch = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        try {
+            if (arg == "--processes") {
+                options.processes = std::stoi(value);
+                if (options.processes <= 0) return false;
+            }
+            else if (arg == "--ticks") {
+                options.ticks = std::stoll(value);
+                if (options.ticks <= 0) return false;
+            }
+            else if (arg == "--config") {
+                options.config = value;
+            }
+            else if (arg == "--format") {
+                if (value != "json" && value != "csv") return false;
+                options.format = value;
+            }
+            else if (arg == "--output") {
+                options.output = value;
+            }
+            else {
+                return false;
+            }
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+    }
+    return batch && (options.processes > 0 || options.ticks > 0);
+}
+
+void BatchRunner::printUsage(std::ostream& out) {
+    out << "Usage: CSOPESY_MP --batch (--processes N | --ticks N) [--config FILE]" << std::endl
+        << "                  [--format json|csv] [--output FILE]" << std::endl
+        << "Without arguments the interactive console starts." << std::endl;
+}
+
+void BatchRunner::watch(Options options) {
+    EventEngine* engine = EventEngine::get();
+    bool enoughTicks = options.ticks > 0 && engine->getTick() >= options.ticks;
+    bool enoughProcesses = options.processes > 0 && Scheduler::get()->getFinishedCount() >= options.processes;
+    // A replayed trace can run out before either limit
+    if (enoughTicks || enoughProcesses || Scheduler::get()->isDrained()) {
+        engine->stop();
+        return;
+    }
+    engine->schedule(1, [options]() { BatchRunner::watch(options); });
+}
@@ -0,0 +1,39 @@
+#pragma once
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <ostream>
+#include <string>
+
+
+// Non-interactive mode for scripted runs and parameter sweeps:
+//
+//   CSOPESY_MP --batch (--processes N | --ticks N) [--config FILE]
+//              [--format json|csv] [--output FILE]
+//
+// Loads the config, runs scheduler-test until N processes have finished
+// or N ticks have passed (whichever comes first when both are given, or
+// earlier if a replayed trace runs out), then writes one summary record and
+// exits.
+class BatchRunner {
+public:
+    // Returns the process exit code: 0 on success, 1 if the config, a trace
+    // or the output file could not be opened, 2 for bad arguments
+    static int run(int argc, char* argv[]);
+
+private:
+    struct Options {
+        std::string config = "config.txt";
+        std::string format = "json";
+        std::string output;
+        int processes = -1;
+        long long ticks = -1;
+    };
+
+    static bool parse(int argc, char* argv[], Options& options);
+    static void printUsage(std::ostream& out);
+    // Engine-thread check, once per tick, for the end of the run
+    static void watch(Options options);
+};
+
+#endif // !BATCHRUNNER_H
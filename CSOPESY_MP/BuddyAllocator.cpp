@@ -0,0 +1,202 @@
+#include "BuddyAllocator.h"
+#include "Process.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "Random.h"
+#include "Scheduler.h"
+
+
+BuddyAllocator::BuddyAllocator(int maxMemory) : _maxMemory(maxMemory), _backingStore(".pagefile"),
+	_generator(Random::generator(Random::EVICTION)) {
+	int maxOrder = BuddyAllocator::orderFor(std::max(maxMemory, 1));
+	this->_freeBlocks.resize(maxOrder + 1);
+	// Memory that isn't a power of two starts out as one block per set bit,
+	// largest first, so every block is aligned to its own size
+	int start = 0;
+	for (int order = maxOrder; order >= 0; order--) {
+		if (maxMemory & (1 << order)) {
+			this->_freeBlocks[order].insert(start);
+			start += 1 << order;
+		}
+	}
+}
+
+bool BuddyAllocator::allocate(std::shared_ptr<Process> process) {
+	if (this->_blocks.find(process->getID()) != this->_blocks.end()) {
+		return true;
+	}
+	int requested = process->getRequestedMemory();
+	int order = BuddyAllocator::orderFor(requested);
+	if (order >= int(this->_freeBlocks.size())) {
+		return false;
+	}
+	for (int retryLimit = 0; retryLimit < 5; retryLimit++) {
+		int start = this->takeBlock(order);
+		if (start >= 0) {
+			this->_resident[start] = process;
+			this->_blocks[process->getID()] = { start, order, requested };
+			this->_usedMemory += 1 << order;
+			this->_requestedMemory += requested;
+			this->_backingStore.swapIn(process);
+			return true;
+		}
+		// Evict whichever resident covers a random address, if it is not running
+		if (!this->_resident.empty()) {
+			auto victim = this->_resident.upper_bound(this->_generator() % this->_maxMemory);
+			if (victim != this->_resident.begin()) {
+				victim--;
+			}
+			if (victim->second->getCPUCoreID() == -1) {
+				this->_backingStore.swapOut(victim->second);
+				this->release(victim);
+			}
+		}
+	}
+	return false;
+}
+
+void BuddyAllocator::deallocate(std::shared_ptr<Process> process) {
+	// A finished process may have been swapped out; its record is no longer needed
+	this->_backingStore.swapIn(process);
+	auto block = this->_blocks.find(process->getID());
+	if (block != this->_blocks.end()) {
+		this->release(this->_resident.find(block->second.start));
+	}
+}
+
+int BuddyAllocator::orderFor(int size) {
+	int order = 0;
+	while ((1 << order) < size) {
+		order++;
+	}
+	return order;
+}
+
+// Start of a free block of exactly 2^order, splitting a larger one if needed
+int BuddyAllocator::takeBlock(int order) {
+	int from = order;
+	while (from < int(this->_freeBlocks.size()) && this->_freeBlocks[from].empty()) {
+		from++;
+	}
+	if (from == int(this->_freeBlocks.size())) {
+		return -1;
+	}
+	int start = *this->_freeBlocks[from].begin();
+	this->_freeBlocks[from].erase(this->_freeBlocks[from].begin());
+	// Keep the low half, free the high half, until the block is small enough
+	while (from > order) {
+		from--;
+		this->_freeBlocks[from].insert(start + (1 << from));
+	}
+	return start;
+}
+
+void BuddyAllocator::freeBlock(int start, int order) {
+	while (order + 1 < int(this->_freeBlocks.size())) {
+		int buddy = start ^ (1 << order);
+		auto found = this->_freeBlocks[order].find(buddy);
+		if (found == this->_freeBlocks[order].end()) {
+			break;
+		}
+		this->_freeBlocks[order].erase(found);
+		start = std::min(start, buddy);
+		order++;
+	}
+	this->_freeBlocks[order].insert(start);
+}
+
+void BuddyAllocator::release(std::map<int, std::shared_ptr<Process>>::iterator resident) {
+	auto block = this->_blocks.find(resident->second->getID());
+	this->freeBlock(block->second.start, block->second.order);
+	this->_usedMemory -= 1 << block->second.order;
+	this->_requestedMemory -= block->second.requested;
+	this->_blocks.erase(block);
+	this->_resident.erase(resident);
+}
+
+void BuddyAllocator::snapshot(MemorySnapshot& out) {
+	out.maxMemory = this->_maxMemory;
+	out.processCount = this->_resident.size();
+	out.externalFragmentation = this->_maxMemory - this->_usedMemory;
+	out.internalFragmentation = this->getInternalFragmentation();
+	out.blocks.reserve(this->_resident.size());
+	for (auto resident = this->_resident.begin(); resident != this->_resident.end(); resident++) {
+		const Block& block = this->_blocks.at(resident->second->getID());
+		out.blocks.push_back({ block.start, block.start + (1 << block.order), resident->second });
+	}
+}
+
+void BuddyAllocator::printProcesses(std::ostream& out) {
+	out << "Memory Usage: " << this->_usedMemory << " / " << this->_maxMemory << std::endl;
+
+	out << "Memory Util: " << (1.0 * this->_usedMemory / this->_maxMemory) * 100 << "%" << std::endl;
+
+	out << std::endl;
+
+	for (int i = 0; i < 48; i++) {
+		out << "=";
+	}
+	out << std::endl;
+
+	out << "Running processes and memory usage: " << std::endl;
+
+	for (int i = 0; i < 48; i++) {
+		out << "-";
+	}
+	out << std::endl;
+
+	for (auto resident = this->_resident.begin(); resident != this->_resident.end(); resident++) {
+		const Block& block = this->_blocks.at(resident->second->getID());
+		out << resident->second->getName() << " " << (1 << block.order)
+			<< " (requested " << block.requested << ")" << std::endl;
+	}
+
+	for (int i = 0; i < 48; i++) {
+		out << "-";
+	}
+	out << std::endl;
+}
+
+void BuddyAllocator::vmstat(std::ostream& out) {
+	int totalTicks = Scheduler::get()->getTotalTicks();
+	int inactiveTicks = Scheduler::get()->getInactiveTicks();
+	int activeTicks = totalTicks - inactiveTicks;
+
+	std::unordered_map<std::string, int> statMap;
+	statMap["K total memory"] = _maxMemory * 1024;
+	statMap["K used memory"] = _usedMemory * 1024;
+	statMap["K active memory"] = _requestedMemory * 1024;
+	statMap["K internal fragmentation"] = this->getInternalFragmentation() * 1024;
+	statMap["idle cpu ticks"] = inactiveTicks;
+	statMap["active cpu ticks"] = activeTicks;
+	statMap["total cpu ticks"] = totalTicks;
+	statMap["num paged in"] = 0;
+	statMap["num paged out"] = 0;
+	int padding = 0;
+	int temp = _maxMemory * 1024;
+	while (temp != 0) {
+		temp /= 10;
+		padding++;
+	}
+	std::vector<std::string> keys;
+	keys.push_back("K total memory");
+	keys.push_back("K used memory");
+	keys.push_back("K active memory");
+	keys.push_back("K internal fragmentation");
+	keys.push_back("idle cpu ticks");
+	keys.push_back("active cpu ticks");
+	keys.push_back("total cpu ticks");
+	keys.push_back("num paged in");
+	keys.push_back("num paged out");
+	for (size_t i = 0; i < keys.size(); i++) {
+		std::string key = keys[i];
+		out << std::setw(padding + 5) << statMap[key] << " " << key << std::endl;
+	}
+}
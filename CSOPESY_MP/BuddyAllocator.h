@@ -0,0 +1,60 @@
+#pragma once
+#ifndef BUDDYALLOCATOR_H
+#define BUDDYALLOCATOR_H
+
+#include "BackingStore.h"
+#include "IAllocator.h"
+#include "Process.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+
+// Binary buddy system. Memory is carved into power-of-two blocks kept in
+// one free set per order; a request takes the smallest order that fits,
+// splitting larger blocks on the way down, and a freed block merges with
+// its buddy (address ^ size) for as long as the buddy is free. Both walks
+// are at most log2(maxMemory) steps.
+class BuddyAllocator : public IAllocator {
+public:
+    BuddyAllocator(int maxMemory);
+    ~BuddyAllocator() = default;
+
+    bool allocate(std::shared_ptr<Process> process) override;
+    void deallocate(std::shared_ptr<Process> process) override;
+
+    void snapshot(MemorySnapshot& out) override;
+    void printProcesses(std::ostream& out) override;
+    void vmstat(std::ostream& out) override;
+
+private:
+    struct Block {
+        int start;
+        int order;
+        int requested;
+    };
+
+    static int orderFor(int size);
+
+    int takeBlock(int order);
+    void freeBlock(int start, int order);
+    void release(std::map<int, std::shared_ptr<Process>>::iterator resident);
+    int getInternalFragmentation() const { return this->_usedMemory - this->_requestedMemory; };
+
+    int _maxMemory;
+    // _freeBlocks[k] holds the start of every free block of size 2^k
+    std::vector<std::set<int>> _freeBlocks;
+    std::map<int, std::shared_ptr<Process>> _resident;
+    std::unordered_map<int, Block> _blocks;
+    int _usedMemory = 0;
+    int _requestedMemory = 0;
+    BackingStore _backingStore;
+    // Picks eviction victims; seeded from the run so evictions replay too
+    std::mt19937 _generator;
+};
+
+#endif //!BUDDYALLOCATOR_H
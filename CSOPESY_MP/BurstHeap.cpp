@@ -0,0 +1,58 @@
+#include "BurstHeap.h"
+
+#include <memory>
+#include <utility>
+
+#include "Process.h"
+
+
+void BurstHeap::push(std::shared_ptr<Process> process) {
+    this->_heap.push_back(std::move(process));
+    this->siftUp(this->_heap.size() - 1);
+}
+
+std::shared_ptr<Process> BurstHeap::top() const {
+    return this->_heap.empty() ? nullptr : this->_heap.front();
+}
+
+std::shared_ptr<Process> BurstHeap::pop() {
+    if (this->_heap.empty()) return nullptr;
+    std::shared_ptr<Process> process = std::move(this->_heap.front());
+    this->_heap.front() = std::move(this->_heap.back());
+    this->_heap.pop_back();
+    if (!this->_heap.empty()) {
+        this->siftDown(0);
+    }
+    return process;
+}
+
+// Shortest remaining burst first; ties go to the older process.
+bool BurstHeap::less(size_t a, size_t b) const {
+    int burstA = this->_heap[a]->getRemainingBurst();
+    int burstB = this->_heap[b]->getRemainingBurst();
+    if (burstA != burstB) return burstA < burstB;
+    return this->_heap[a]->getID() < this->_heap[b]->getID();
+}
+
+void BurstHeap::siftUp(size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!this->less(index, parent)) break;
+        std::swap(this->_heap[index], this->_heap[parent]);
+        index = parent;
+    }
+}
+
+void BurstHeap::siftDown(size_t index) {
+    size_t size = this->_heap.size();
+    while (true) {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < size && this->less(left, smallest)) smallest = left;
+        if (right < size && this->less(right, smallest)) smallest = right;
+        if (smallest == index) break;
+        std::swap(this->_heap[index], this->_heap[smallest]);
+        index = smallest;
+    }
+}
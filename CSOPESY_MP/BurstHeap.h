@@ -0,0 +1,35 @@
+#pragma once
+#ifndef BURSTHEAP_H
+#define BURSTHEAP_H
+
+#include <memory>
+#include <vector>
+
+#include "Process.h"
+
+
+// Binary min-heap of processes keyed on their cached remaining burst.
+// Comparisons only read the cached burst, never shared process state. A
+// queued process is not running, so its burst cannot change while it is in
+// here and entries never need re-keying.
+class BurstHeap {
+public:
+    BurstHeap() = default;
+    ~BurstHeap() = default;
+
+    void push(std::shared_ptr<Process> process);
+    std::shared_ptr<Process> top() const;
+    std::shared_ptr<Process> pop();
+
+    size_t size() const { return this->_heap.size(); };
+    bool empty() const { return this->_heap.empty(); };
+
+private:
+    bool less(size_t a, size_t b) const;
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+
+    std::vector<std::shared_ptr<Process>> _heap;
+};
+
+#endif // !BURSTHEAP_H
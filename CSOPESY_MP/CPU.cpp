@@ -1,51 +1,107 @@
 #include "CPU.h"
 
+#include "EventEngine.h"
 #include "Process.h"
+#include "Scheduler.h"
 
 #include <memory>
 #include <mutex>
-#include <thread>
 
 
 int CPU::nextID = 0;
-int CPU::msDelay = 50;
 
 CPU::CPU() {
     this->_id = CPU::nextID;
     CPU::nextID++;
-    std::thread tickThread(&CPU::run, this);
-    tickThread.detach();
+    this->_startTick = EventEngine::get()->getTick();
+}
+
+// Idle ticks are never simulated, so they are whatever part of the elapsed
+// virtual time this core did not spend executing.
+int CPU::getTotalTicks() {
+    return int(EventEngine::get()->getTick() - this->_startTick);
+}
+
+std::shared_ptr<Process> CPU::getProcess() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    return this->_process;
 }
 
 void CPU::setProcess(std::shared_ptr<Process> process) {
     std::lock_guard<std::mutex> lock(this->mtx);
+    long long tick = EventEngine::get()->getTick();
     if (this->_process != nullptr) {
         this->_process->setCPUCoreID(-1);
+        if (!this->_process->hasFinished()) {
+            this->_process->markDescheduled(tick);
+        }
+    }
+    if (process != nullptr) {
+        process->setCPUCoreID(this->_id);
+        process->markDispatched(tick);
     }
     this->_process = process;
     this->_ready = process == nullptr;
+    this->_quantumCounter = 0;
+    this->_quantumExpired = false;
+    if (process != nullptr && !this->_tickPending) {
+        this->_tickPending = true;
+        EventEngine::get()->schedule(1, [this]() { this->run(); });
+    }
 }
 
+// One tick of this core. Keeps itself armed only while there is something to
+// run, and wakes the scheduler once the core goes idle or its quantum is up.
+// Both run on the engine thread, so re-arming takes no lock.
 void CPU::run() {
-    this->_stopFlag = false;
-    while (!this->_stopFlag) {
-        this->execute();
-        std::this_thread::sleep_for(std::chrono::milliseconds(CPU::msDelay));
+    this->_tickPending = false;
+    if (this->_stopFlag) {
+        this->_ready = true;
+        return;
+    }
+    if (this->execute()) {
+        this->_tickPending = true;
+        EventEngine::get()->schedule(1, [this]() { this->run(); });
+    }
+    else {
+        Scheduler::get()->requestDispatch();
     }
-    this->_ready = true;
 }
 
-void CPU::execute() {
-    std::lock_guard<std::mutex> lock(this->mtx);
-    this->_totalTicks++;
-    if (this->_process != nullptr && !this->_process->hasFinished()) {
-        this->_process->setCPUCoreID(this->_id);
-        this->_process->execute();
-        if (this->_process->hasFinished()) {
+// The per-instruction path. PRINT output goes onto LogWriter's lock-free
+// queue, so the only lock taken here, or anywhere in a tick, is the memory
+// manager's, and only for allocators that track accesses (paging).
+// Retires up to _instructionsPerTick instructions. The quantum counts only
+// instructions actually retired, so page faults and sleeping never use it
+// up; a slice can still end partway through a tick. SLEEP counts ticks
+// whatever the batch size: a tick spent asleep, or one that starts a
+// SLEEP, retires nothing more.
+bool CPU::execute() {
+    Process* process = this->_process.get();
+    if (process == nullptr || process->hasFinished()) {
+        return false;
+    }
+    this->_activeTicks++;
+    MemoryManager* memory = Scheduler::get()->getMemoryManager();
+    for (int i = 0; i < this->_instructionsPerTick; i++) {
+        // A page fault costs the rest of the tick; the instruction runs on the next one
+        bool resident = memory->access(this->_process);
+        bool retired = resident && process->execute();
+        if (retired) {
+            this->_quantumCounter++;
+        }
+        if (process->hasFinished()) {
+            process->markFinished(EventEngine::get()->getTick());
+            Scheduler::get()->recordFinished(this->_process);
             this->_ready = true;
+            return false;
         }
+        if (this->_quantum > 0 && this->_quantumCounter >= this->_quantum) {
+            this->_quantumExpired = true;
+            Scheduler::get()->recordQuantumExpired();
+            return false;
+        }
+        if (!retired || process->isSleeping()) break;
     }
-    else {
-        this->_inactiveTicks++;
-    }
+    return true;
 }
@@ -6,6 +6,7 @@
 #include <string>
 
 #include "Process.h"
+#include "RunQueue.h"
 #include <mutex>
 
 
@@ -15,34 +16,45 @@ public:
     ~CPU() = default;
     void setProcess(std::shared_ptr<Process> process);
     int getId() const { return _id; };
-    std::string getProcessName() const { return this->_process->getName(); };
-    int getProcessCommandCounter() const { return this->_process->getCommandCounter(); };
-    int getProcessCommandListSize() const { return this->_process->getCommandListSize(); };
-    time_t getProcessArrivalTime() const { return this->_process->getArrivalTime(); };
-    std::shared_ptr<Process> getProcess() { return this->_process; };
-    int getTotalTicks() { return this->_totalTicks; };
-    int getInactiveTicks() { return this->_inactiveTicks; };
+    // Safe from any thread; the process may be swapped out right after
+    std::shared_ptr<Process> getProcess();
+    RunQueue& getRunQueue() { return this->_runQueue; };
+    int getTotalTicks();
+    int getInactiveTicks() { return this->getTotalTicks() - this->_activeTicks; };
 
     void stop() { this->_stopFlag = true; };
     bool isReady() const { return _ready; };
     void setReady() { this->_ready = true; };
-    static void setMsDelay(int delay) { CPU::msDelay = delay; };
+    void setQuantum(int quantum) { this->_quantum = quantum; };
+    void setInstructionsPerTick(int count) { this->_instructionsPerTick = count; };
+    bool isQuantumExpired() const { return this->_quantumExpired; };
 
 private:
     void run();
-    void execute();
+    bool execute();
 
+    // Guards _process against readers on other threads. Only the engine
+    // thread ever replaces it, so run() and execute() read it unlocked.
     std::mutex mtx;
-    static int msDelay;
 
     static int nextID;
     int _id;
     bool _ready = true;
     bool _stopFlag = false;
-    int _inactiveTicks = 0;
-    int _totalTicks = 0;
+    bool _tickPending = false;
+    long long _startTick = 0;
+    int _activeTicks = 0;
+    // Instructions retired per tick before the core goes back to the engine
+    int _instructionsPerTick = 1;
+
+    // Instructions retired by the current process since it was dispatched
+    // here; once it reaches _quantum (if set) the core yields it back.
+    int _quantum = 0;
+    int _quantumCounter = 0;
+    bool _quantumExpired = false;
 
     std::shared_ptr<Process> _process = nullptr;
+    RunQueue _runQueue;
 };
 
 #endif // !CPU_H
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Config.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -15,11 +16,11 @@ Config::~Config() {
 
 std::string Config::_scheduler = "";
 
-void Config::initialize() {
-    ifstream inputFile("config.txt");
+bool Config::initialize(std::string path) {
+    ifstream inputFile(path);
     if (!inputFile.is_open()) {
-        cerr << "Failed to open the file." << endl;
-        return;
+        cerr << "Failed to open " << path << "." << endl;
+        return false;
     }
 
     unordered_map<string, string> config;
@@ -46,6 +47,31 @@ void Config::initialize() {
     float delay_per_exec = stof(config["delay-per-exec"]);
     int min_page_proc = 2;
     int max_page_proc = stoi(config["mem-per-frame"]);
+    // Optional: "realtime" paces ticks on the wall clock, "fast" runs the simulation unpaced
+    string sim_mode = config.count("sim-mode") ? config["sim-mode"].substr(1, config["sim-mode"].size() - 2) : "realtime";
+    // Optional, only used by the "mlfq" scheduler
+    int mlfq_levels = config.count("mlfq-levels") ? stoi(config["mlfq-levels"]) : 3;
+    int mlfq_boost_ticks = config.count("mlfq-boost-ticks") ? stoi(config["mlfq-boost-ticks"]) : 1000;
+    // Optional: "flat", "paging" or "buddy"; by default paging unless processes are one page
+    string allocator = config.count("allocator") ? config["allocator"].substr(1, config["allocator"].size() - 2)
+        : (min_page_proc == 1 && max_page_proc == 1 ? "flat" : "paging");
+    // Optional: "first", "best" or "worst", for the contiguous allocator
+    string fit_policy = config.count("fit-policy") ? config["fit-policy"].substr(1, config["fit-policy"].size() - 2) : "first";
+    // Optional: "fifo", "lru", "clock" or "second-chance", for the paging allocator
+    string page_replacement = config.count("page-replacement") ? config["page-replacement"].substr(1, config["page-replacement"].size() - 2) : "fifo";
+    // Optional: where RR writes memory_stamp_<cycle>.txt every quantum cycle; off when absent
+    string memory_stamp_dir = config.count("memory-stamp-dir") ? config["memory-stamp-dir"].substr(1, config["memory-stamp-dir"].size() - 2) : "";
+    // Optional: fixes every random draw of the run; 0 or absent picks one
+    unsigned int seed = config.count("seed") ? unsigned(stoul(config["seed"])) : 0;
+    // Optional: write every arrival to this trace file, or take arrivals from one instead of generating them
+    string trace_record = config.count("trace-record") ? config["trace-record"].substr(1, config["trace-record"].size() - 2) : "";
+    string trace_replay = config.count("trace-replay") ? config["trace-replay"].substr(1, config["trace-replay"].size() - 2) : "";
+    // Optional: how many finished processes to keep listing; absent or negative keeps them all
+    int finished_retention = config.count("finished-retention") ? stoi(config["finished-retention"]) : -1;
+    // Optional: instructions a core retires per tick, between scheduler interactions
+    int instructions_per_tick = config.count("instructions-per-tick") ? stoi(config["instructions-per-tick"]) : 1;
+    // Optional: real-time pacing in (fractional) milliseconds per tick; absent keeps delay-per-exec * 100
+    float ms_per_tick = config.count("ms-per-tick") ? stof(config["ms-per-tick"]) : delay_per_exec * 100;
 
 
     this->_numCpu = num_cpu;
@@ -61,4 +87,18 @@ void Config::initialize() {
     this->_delaysPerExec = delay_per_exec;
     this->_minPageProc = min_page_proc;
     this->_maxPageProc = max_page_proc;
+    this->_realTime = sim_mode != "fast";
+    this->_mlfqLevels = mlfq_levels;
+    this->_mlfqBoostTicks = mlfq_boost_ticks;
+    this->_allocator = allocator;
+    this->_fitPolicy = fit_policy;
+    this->_pageReplacement = page_replacement;
+    this->_memoryStampDir = memory_stamp_dir;
+    this->_seed = seed;
+    this->_traceRecord = trace_record;
+    this->_traceReplay = trace_replay;
+    this->_finishedRetention = finished_retention;
+    this->_instructionsPerTick = std::max(1, instructions_per_tick);
+    this->_msPerTick = std::max(0.0f, ms_per_tick);
+    return true;
 }
\ No newline at end of file
@@ -11,7 +11,8 @@ class Config
 public:
     Config();
     ~Config();
-    void initialize();
+    // False if the file could not be read
+    bool initialize(std::string path = "config.txt");
 
     int getNumCpu() const {
         return _numCpu;
@@ -65,6 +66,64 @@ public:
         return _maxPageProc;
     }
 
+    int getMlfqLevels() const {
+        return _mlfqLevels;
+    }
+
+    int getMlfqBoostTicks() const {
+        return _mlfqBoostTicks;
+    }
+
+    std::string getAllocator() const {
+        return _allocator;
+    }
+
+    std::string getFitPolicy() const {
+        return _fitPolicy;
+    }
+
+    std::string getPageReplacement() const {
+        return _pageReplacement;
+    }
+
+    std::string getMemoryStampDir() const {
+        return _memoryStampDir;
+    }
+
+    unsigned int getSeed() const {
+        return _seed;
+    }
+
+    std::string getTraceRecord() const {
+        return _traceRecord;
+    }
+
+    std::string getTraceReplay() const {
+        return _traceReplay;
+    }
+
+    int getFinishedRetention() const {
+        return _finishedRetention;
+    }
+
+    int getInstructionsPerTick() const {
+        return _instructionsPerTick;
+    }
+
+    // Real-time pacing of one tick on the wall clock; 0 runs unpaced
+    float getMsPerTick() const {
+        return _msPerTick;
+    }
+
+    bool isRealTime() const {
+        return _realTime;
+    }
+
+    // Batch mode always runs on virtual time, whatever sim-mode says
+    void forceFastMode() {
+        _realTime = false;
+    }
+
     bool isRunning() const {
         return running;
     }
@@ -82,6 +141,19 @@ private:
     float _delaysPerExec;
     int _minPageProc;
     int _maxPageProc;
+    bool _realTime;
+    int _mlfqLevels;
+    int _mlfqBoostTicks;
+    string _allocator;
+    string _fitPolicy;
+    string _pageReplacement;
+    string _memoryStampDir;
+    unsigned int _seed;
+    string _traceRecord;
+    string _traceReplay;
+    int _finishedRetention;
+    int _instructionsPerTick;
+    float _msPerTick;
     bool running = false;
 
     friend class Scheduler;
@@ -26,69 +26,100 @@ void ConsoleManager::start() {
 }
 
 bool ConsoleManager::newConsole(std::string name, AConsole_ console) {
-    if (this->_consoleMap.find(name) != this->_consoleMap.end()) {
+    if (console != nullptr) {
+        if (this->_consoleMap.find(name) != this->_consoleMap.end()) {
+            std::cout << "Process '" + name + "' is already running!" << std::endl;
+            return false;
+        }
+        this->_consoleMap[name] = console;
+        return true;
+    }
+
+    int pid = this->_scheduler->findPid(name);
+    if (this->_processConsoles.find(pid) != this->_processConsoles.end()) {
         std::cout << "Process '" + name + "' is already running!" << std::endl;
         return false;
     }
-
-    bool found = false;
-    if (console == nullptr) {
-        std::vector<std::shared_ptr<Process>> copyList = this->_scheduler->_processList;
-        for (int i = 0; i < copyList.size(); i++) {
-            if (name == copyList.at(i)->getName() && !copyList.at(i)->hasFinished()) {
-                console = std::make_shared<ProcessConsole>(copyList.at(i));
-                found = true;
-                break;
-            }
-        }
-        if (found)
-            this->_consoleMap[name] = console;
-        /*else {
-            std::uniform_int_distribution<int> commandDistr(this->_scheduler->minIns, this->_scheduler->maxIns);
-            std::uniform_int_distribution<int> memDistr(this->_scheduler->_minMemProc, this->_scheduler->_maxMemProc);
-            std::uniform_int_distribution<int> pageDistr(this->_scheduler->_minPage, this->_scheduler->_maxPage);
-
-            auto newProcess = std::make_shared<Process>(name, commandDistr, memDistr, pageDistr);
-            this->_scheduler->addProcess(newProcess);
-            console = std::make_shared<ProcessConsole>(newProcess);
-            this->_consoleMap[name] = console;
-            found = true;
-        }*/
-        this->switchConsole(name);
+    std::shared_ptr<Process> process = this->_scheduler->getProcess(pid);
+    if (process == nullptr) {
+        // No process by that name yet: create one. It joins the admission
+        // queue like any other arrival, so the scheduler only indexes its name
+        // once the engine admits it; open its screen directly meanwhile.
+        process = this->_scheduler->createProcess(name);
+        this->_scheduler->addProcess(process);
+        AConsole_ console = std::make_shared<ProcessConsole>(process);
+        this->_processConsoles[process->getID()] = console;
+        this->openConsole(console, name, process->getID());
+        return true;
     }
-    else {
-        this->_consoleMap[name] = console;
+    if (!process->hasFinished()) {
+        this->_processConsoles[pid] = std::make_shared<ProcessConsole>(process);
     }
+    this->switchConsole(name);
 
     return true;
 }
 
 void ConsoleManager::switchConsole(std::string processName) {
-    if (this->_consoleMap.find(processName) == this->_consoleMap.end()) {
+    int pid;
+    AConsole_ console = this->findConsole(processName, pid);
+    if (console == nullptr) {
         std::cout << "Process " + processName + " not found." << std::endl;
         return;
     }
-    else if (this->_consoleMap[processName]->canRemove()) {
-        this->_consoleMap.erase(processName);
+    else if (console->canRemove()) {
+        this->removeConsole(processName, pid);
         std::cout << "Process " + processName + " not found." << std::endl;
         return;
     }
+    this->openConsole(console, processName, pid);
+}
 
+void ConsoleManager::openConsole(AConsole_ console, const std::string& name, int pid) {
     this->_current->stop();
 
-    this->_current = this->_consoleMap[processName];
+    this->_current = console;
     this->_current->run();
 
     // Wait for console to set active to false
     while (this->_current->isActive()) {}
 
     if (this->_current->canRemove())
-        this->_consoleMap.erase(processName);
+        this->removeConsole(name, pid);
 
     this->_current = this->_mainConsole;
     this->_current->run();
 }
 
+// Named consoles first, then process screens through the scheduler's
+// name index; pid is -1 unless a process screen was found
+AConsole_ ConsoleManager::findConsole(const std::string& name, int& pid) {
+    pid = -1;
+    auto named = this->_consoleMap.find(name);
+    if (named != this->_consoleMap.end()) {
+        return named->second;
+    }
+    if (this->_scheduler == nullptr) {
+        return nullptr;
+    }
+    int found = this->_scheduler->findPid(name);
+    auto screen = this->_processConsoles.find(found);
+    if (screen == this->_processConsoles.end()) {
+        return nullptr;
+    }
+    pid = found;
+    return screen->second;
+}
+
+void ConsoleManager::removeConsole(const std::string& name, int pid) {
+    if (pid >= 0) {
+        this->_processConsoles.erase(pid);
+    }
+    else {
+        this->_consoleMap.erase(name);
+    }
+}
+
 ConsoleManager::ConsoleManager() {
     this->_mainConsole = std::make_shared<MainConsole>(MainConsole(this));
     this->_current = this->_mainConsole;
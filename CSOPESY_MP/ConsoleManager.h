@@ -29,8 +29,15 @@ private:
     ConsoleManager();
     ~ConsoleManager();
 
+    AConsole_ findConsole(const std::string& name, int& pid);
+    // Runs console until it exits, then returns to the main console
+    void openConsole(AConsole_ console, const std::string& name, int pid);
+    void removeConsole(const std::string& name, int pid);
+
     static ConsoleManager* ptr;
+    // Named consoles (marquee), and process screens by PID
     std::unordered_map<std::string, AConsole_> _consoleMap;
+    std::unordered_map<int, AConsole_> _processConsoles;
     AConsole_ _current = nullptr;
     AConsole_ _mainConsole = nullptr;
 
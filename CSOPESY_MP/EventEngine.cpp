@@ -0,0 +1,118 @@
+#include "EventEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+
+EventEngine* EventEngine::_ptr = nullptr;
+thread_local EventEngine* EventEngine::_current = nullptr;
+
+EventEngine* EventEngine::get() {
+    return EventEngine::_ptr;
+}
+
+void EventEngine::initialize(bool realTime, float msPerTick) {
+    EventEngine::_ptr = new EventEngine(realTime, msPerTick);
+}
+
+void EventEngine::destroy() {
+    if (EventEngine::_ptr == nullptr) return;
+    EventEngine::_ptr->stop();
+    delete EventEngine::_ptr;
+    EventEngine::_ptr = nullptr;
+}
+
+EventEngine::EventEngine(bool realTime, float msPerTick) :
+    _realTime(realTime),
+    _msPerTick(realTime ? msPerTick : 0) {
+}
+
+void EventEngine::start() {
+    if (this->running == false && !this->_thread.joinable()) {
+        this->running = true;
+        this->_thread = std::thread(&EventEngine::run, this);
+    }
+}
+
+void EventEngine::stop() {
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->running = false;
+    }
+    this->cv.notify_all();
+    if (this->_thread.joinable() && this->_thread.get_id() != std::this_thread::get_id()) {
+        this->_thread.join();
+    }
+}
+
+// Only the engine thread (i.e. event callbacks) should schedule relative to
+// the current tick; other threads go through post().
+void EventEngine::schedule(long long delay, Callback callback) {
+    if (EventEngine::_current == this) {
+        this->_eventQueue.push({ this->_tick + delay, this->_nextSeq++, std::move(callback) });
+        return;
+    }
+    // Only the push that finds the queue empty has to wake the engine. Taking
+    // the mutex first means the wake-up cannot slip in between the engine
+    // finding nothing to do and going to sleep.
+    if (this->_posted.push({ delay, std::move(callback) })) {
+        { std::lock_guard<std::mutex> lock(this->mtx); }
+        this->cv.notify_one();
+    }
+}
+
+void EventEngine::post(Callback callback) {
+    this->schedule(0, std::move(callback));
+}
+
+void EventEngine::mergePosted() {
+    this->_posted.drain(this->_merging);
+    for (Posted& posted : this->_merging) {
+        this->_eventQueue.push({ this->_tick + posted.delay, this->_nextSeq++, std::move(posted.callback) });
+    }
+    this->_merging.clear();
+}
+
+void EventEngine::run() {
+    EventEngine::_current = this;
+    this->_startTime = std::chrono::steady_clock::now();
+    auto woken = [this]() { return !this->running || !this->_posted.empty(); };
+    while (this->running) {
+        this->mergePosted();
+        if (this->_eventQueue.empty()) {
+            std::unique_lock<std::mutex> lock(this->mtx);
+            this->cv.wait(lock, woken);
+            // Time kept passing while we slept; don't replay the idle ticks
+            this->_tick = std::max(this->_tick.load(), this->getWallTick());
+            continue;
+        }
+
+        long long due = this->_eventQueue.top().tick;
+        if (due > this->_tick && this->_msPerTick > 0) {
+            std::chrono::duration<double, std::milli> offset(due * double(this->_msPerTick));
+            auto deadline = this->_startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset);
+            if (std::chrono::steady_clock::now() < deadline) {
+                // Woken early by post() so work arriving now isn't held back a tick
+                std::unique_lock<std::mutex> lock(this->mtx);
+                this->cv.wait_until(lock, deadline, woken);
+                continue;
+            }
+        }
+
+        Event event = this->_eventQueue.top();
+        this->_eventQueue.pop();
+        if (event.tick > this->_tick) {
+            this->_tick = event.tick;
+        }
+        event.callback();
+    }
+    EventEngine::_current = nullptr;
+}
+
+long long EventEngine::getWallTick() const {
+    if (this->_msPerTick <= 0) return 0;
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - this->_startTime;
+    return (long long)(elapsed.count() / this->_msPerTick);
+}
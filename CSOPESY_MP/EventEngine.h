@@ -0,0 +1,98 @@
+#pragma once
+#ifndef EVENTENGINE_H
+#define EVENTENGINE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "MPSCQueue.h"
+
+
+// Discrete-event core shared by the Scheduler and every CPU. Holds a virtual
+// tick clock and a queue of callbacks ordered by the tick they are due on.
+// In fast mode the clock jumps straight to the next due event; in real-time
+// mode each tick is additionally paced to msPerTick of wall-clock time.
+// The engine thread blocks on a condition variable whenever nothing is due,
+// so an idle simulation costs no host CPU. The thread is joined on stop(),
+// so nothing still runs inside the engine once it is destroyed.
+// The event queue belongs to the engine thread: callbacks scheduling more
+// work (every CPU tick) push onto it directly, with no lock; other threads
+// hand events over through a lock-free queue that is merged in before each
+// event runs, and only take the mutex to wake the engine up.
+class EventEngine {
+public:
+    typedef std::function<void()> Callback;
+
+    static EventEngine* get();
+    static void initialize(bool realTime, float msPerTick);
+    static void destroy();
+
+    void start();
+    // Joins the engine thread, unless called from an event callback; the
+    // engine then stops after that callback and a later stop() joins it
+    void stop();
+
+    void schedule(long long delay, Callback callback);
+    void post(Callback callback);
+
+    long long getTick() const { return this->_tick; };
+    bool isRealTime() const { return this->_realTime; };
+    bool isRunning() const { return this->running; };
+
+private:
+    EventEngine(bool realTime, float msPerTick);
+    ~EventEngine() = default;
+
+    struct Event {
+        long long tick;
+        long long seq;
+        Callback callback;
+    };
+
+    // Handed over by another thread; its tick is fixed once it is merged in
+    struct Posted {
+        long long delay;
+        Callback callback;
+    };
+
+    struct EventCompare {
+        bool operator()(const Event& a, const Event& b) const {
+            if (a.tick != b.tick) return a.tick > b.tick;
+            return a.seq > b.seq;
+        }
+    };
+
+    void run();
+    void mergePosted();
+    long long getWallTick() const;
+
+    static EventEngine* _ptr;
+    // The engine whose thread this is, if any
+    static thread_local EventEngine* _current;
+
+    // Only guards sleeping and waking the engine thread
+    std::mutex mtx;
+    std::condition_variable cv;
+    MPSCQueue<Posted> _posted;
+
+    // Engine thread only
+    std::priority_queue<Event, std::vector<Event>, EventCompare> _eventQueue;
+    std::vector<Posted> _merging;
+    long long _nextSeq = 0;
+    std::atomic<long long> _tick{ 0 };
+
+    bool _realTime;
+    float _msPerTick;
+    std::chrono::steady_clock::time_point _startTime;
+
+    std::atomic<bool> running{ false };
+    std::thread _thread;
+};
+
+#endif // !EVENTENGINE_H
@@ -2,33 +2,42 @@
 #ifndef FLATALLOCATOR_H
 #define FLATALLOCATOR_H
 
+#include "BackingStore.h"
+#include "FreeList.h"
 #include "IAllocator.h"
 #include "Process.h"
 
+#include <map>
 #include <memory>
-#include <vector>
-#include <utility>
+#include <random>
 #include <string>
+#include <unordered_map>
 
 
 class FlatAllocator : public IAllocator {
 public:
-    FlatAllocator(int maxMemory);
+    FlatAllocator(int maxMemory, std::string fitPolicy);
     ~FlatAllocator() = default;
 
     bool allocate(std::shared_ptr<Process> process) override;
     void deallocate(std::shared_ptr<Process> process) override;
 
-    void printMem() override;
+    void snapshot(MemorySnapshot& out) override;
 
-    void printProcesses() override;
-    void vmstat() override;
+    void printProcesses(std::ostream& out) override;
+    void vmstat(std::ostream& out) override;
 
 private:
-    void readBackingStore(std::shared_ptr<Process> process);
-    void writeBackingStore(std::shared_ptr<Process> process);
+    void release(std::map<int, std::shared_ptr<Process>>::iterator block);
+
     int _maxMemory;
-    std::vector<std::pair<std::shared_ptr<Process>, std::pair<int, int>>> _memory;
+    FreeList _freeList;
+    // Resident processes by start address, and each one's start by PID
+    std::map<int, std::shared_ptr<Process>> _resident;
+    std::unordered_map<int, int> _startOf;
+    BackingStore _backingStore;
+    // Picks eviction victims; seeded from the run so evictions replay too
+    std::mt19937 _generator;
 };
 
 #endif //!FLATALLOCATOR_H
\ No newline at end of file
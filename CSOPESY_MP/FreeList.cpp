@@ -0,0 +1,208 @@
+#include "FreeList.h"
+
+#include <algorithm>
+#include <iterator>
+
+
+FreeList::FreeList(int size, Policy policy) : _policy(policy) {
+    if (size > 0) {
+        this->insertBlock(0, size);
+    }
+}
+
+FreeList::Policy FreeList::parsePolicy(const std::string& name) {
+    if (name == "best") return BEST_FIT;
+    if (name == "worst") return WORST_FIT;
+    return FIRST_FIT;
+}
+
+int FreeList::allocate(int size) {
+    if (size <= 0 || this->_bySize.empty()) return -1;
+
+    int start;
+    int blockSize;
+    if (this->_policy == FIRST_FIT) {
+        int node = this->findFirstFit(size);
+        if (node == -1) return -1;
+        start = this->_nodes[node].start;
+        blockSize = this->_nodes[node].size;
+    }
+    else {
+        std::set<std::pair<int, int>>::iterator block;
+        if (this->_policy == BEST_FIT) {
+            block = this->_bySize.lower_bound({ size, -1 });
+            if (block == this->_bySize.end()) return -1;
+        }
+        else {
+            block = std::prev(this->_bySize.end());
+            if (block->first < size) return -1;
+        }
+        blockSize = block->first;
+        start = block->second;
+    }
+
+    // Carve from the front; the remainder stays free where it was
+    this->eraseBlock(start, blockSize);
+    if (blockSize > size) {
+        this->insertBlock(start + size, blockSize - size);
+    }
+    return start;
+}
+
+void FreeList::release(int start, int size) {
+    if (size <= 0) return;
+
+    int before = this->findBefore(start);
+    if (before != -1 && this->_nodes[before].start + this->_nodes[before].size == start) {
+        int beforeStart = this->_nodes[before].start;
+        int beforeSize = this->_nodes[before].size;
+        this->eraseBlock(beforeStart, beforeSize);
+        start = beforeStart;
+        size += beforeSize;
+    }
+    int after = this->findAfter(start);
+    if (after != -1 && this->_nodes[after].start == start + size) {
+        int afterSize = this->_nodes[after].size;
+        this->eraseBlock(this->_nodes[after].start, afterSize);
+        size += afterSize;
+    }
+    this->insertBlock(start, size);
+}
+
+int FreeList::getLargestBlock() const {
+    return this->_bySize.empty() ? 0 : this->_bySize.rbegin()->first;
+}
+
+std::vector<std::pair<int, int>> FreeList::getBlocks() const {
+    std::vector<std::pair<int, int>> blocks;
+    blocks.reserve(this->_bySize.size());
+    for (const std::pair<int, int>& block : this->_bySize) {
+        blocks.push_back({ block.second, block.first });
+    }
+    std::sort(blocks.begin(), blocks.end());
+    return blocks;
+}
+
+int FreeList::newNode(int start, int size) {
+    // xorshift32; priorities only need to look random to keep the treap balanced
+    this->_seed ^= this->_seed << 13;
+    this->_seed ^= this->_seed >> 17;
+    this->_seed ^= this->_seed << 5;
+    Node node = { start, size, size, this->_seed, -1, -1 };
+    if (!this->_freeNodes.empty()) {
+        int index = this->_freeNodes.back();
+        this->_freeNodes.pop_back();
+        this->_nodes[index] = node;
+        return index;
+    }
+    this->_nodes.push_back(node);
+    return int(this->_nodes.size()) - 1;
+}
+
+void FreeList::update(int node) {
+    Node& n = this->_nodes[node];
+    n.maxSize = n.size;
+    if (n.left != -1) n.maxSize = std::max(n.maxSize, this->_nodes[n.left].maxSize);
+    if (n.right != -1) n.maxSize = std::max(n.maxSize, this->_nodes[n.right].maxSize);
+}
+
+// left receives blocks starting before key, right the rest
+void FreeList::split(int node, int key, int& left, int& right) {
+    if (node == -1) {
+        left = right = -1;
+        return;
+    }
+    if (this->_nodes[node].start < key) {
+        this->split(this->_nodes[node].right, key, this->_nodes[node].right, right);
+        left = node;
+    }
+    else {
+        this->split(this->_nodes[node].left, key, left, this->_nodes[node].left);
+        right = node;
+    }
+    this->update(node);
+}
+
+int FreeList::merge(int left, int right) {
+    if (left == -1) return right;
+    if (right == -1) return left;
+    if (this->_nodes[left].priority > this->_nodes[right].priority) {
+        this->_nodes[left].right = this->merge(this->_nodes[left].right, right);
+        this->update(left);
+        return left;
+    }
+    this->_nodes[right].left = this->merge(left, this->_nodes[right].left);
+    this->update(right);
+    return right;
+}
+
+void FreeList::insertBlock(int start, int size) {
+    int left, right;
+    this->split(this->_root, start, left, right);
+    this->_root = this->merge(this->merge(left, this->newNode(start, size)), right);
+    this->_bySize.insert({ size, start });
+    this->_freeMemory += size;
+}
+
+void FreeList::eraseBlock(int start, int size) {
+    int left, middle, right;
+    this->split(this->_root, start, left, right);
+    this->split(right, start + 1, middle, right);
+    if (middle != -1) {
+        this->_freeNodes.push_back(middle);
+    }
+    this->_root = this->merge(left, right);
+    this->_bySize.erase({ size, start });
+    this->_freeMemory -= size;
+}
+
+// Lowest-addressed block of at least size, steering by subtree maxima
+int FreeList::findFirstFit(int size) const {
+    int node = this->_root;
+    while (node != -1) {
+        const Node& n = this->_nodes[node];
+        if (n.left != -1 && this->_nodes[n.left].maxSize >= size) {
+            node = n.left;
+        }
+        else if (n.size >= size) {
+            return node;
+        }
+        else if (n.right != -1 && this->_nodes[n.right].maxSize >= size) {
+            node = n.right;
+        }
+        else {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+int FreeList::findBefore(int start) const {
+    int node = this->_root;
+    int found = -1;
+    while (node != -1) {
+        if (this->_nodes[node].start < start) {
+            found = node;
+            node = this->_nodes[node].right;
+        }
+        else {
+            node = this->_nodes[node].left;
+        }
+    }
+    return found;
+}
+
+int FreeList::findAfter(int start) const {
+    int node = this->_root;
+    int found = -1;
+    while (node != -1) {
+        if (this->_nodes[node].start > start) {
+            found = node;
+            node = this->_nodes[node].left;
+        }
+        else {
+            node = this->_nodes[node].right;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef FREELIST_H
+#define FREELIST_H
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+// Free blocks of a contiguous address space, indexed two ways: a treap
+// ordered by address (each node also tracks the largest block in its
+// subtree, for first-fit and neighbour lookups) and a set ordered by size
+// (for best- and worst-fit). Allocation, release and coalescing are all
+// O(log n) in the number of free blocks.
+class FreeList {
+public:
+    enum Policy {
+        FIRST_FIT,
+        BEST_FIT,
+        WORST_FIT
+    };
+
+    FreeList(int size, Policy policy);
+    ~FreeList() = default;
+
+    static Policy parsePolicy(const std::string& name);
+
+    // Returns the start of the carved-out range, or -1 if nothing fits
+    int allocate(int size);
+    // Returns a range to the free list, merging it with free neighbours
+    void release(int start, int size);
+
+    int getFreeMemory() const { return this->_freeMemory; };
+    int getLargestBlock() const;
+    int getBlockCount() const { return int(this->_bySize.size()); };
+    // (start, size) of every free block in address order
+    std::vector<std::pair<int, int>> getBlocks() const;
+
+private:
+    struct Node {
+        int start;
+        int size;
+        int maxSize;
+        uint32_t priority;
+        int left;
+        int right;
+    };
+
+    int newNode(int start, int size);
+    void update(int node);
+    void split(int node, int key, int& left, int& right);
+    int merge(int left, int right);
+
+    void insertBlock(int start, int size);
+    void eraseBlock(int start, int size);
+    int findFirstFit(int size) const;
+    int findBefore(int start) const;
+    int findAfter(int start) const;
+
+    Policy _policy;
+    std::vector<Node> _nodes;
+    std::vector<int> _freeNodes;
+    int _root = -1;
+    uint32_t _seed = 2463534242u;
+
+    std::set<std::pair<int, int>> _bySize;
+    int _freeMemory = 0;
+};
+
+#endif // !FREELIST_H
@@ -2,18 +2,32 @@
 #ifndef IALLOCATOR_H
 #define IALLOCATOR_H
 
+#include "MemorySnapshot.h"
 #include "Process.h"
 
 #include <memory>
+#include <ostream>
 
 
 class IAllocator {
 public:
+    virtual ~IAllocator() = default;
     virtual bool allocate(std::shared_ptr<Process> process) = 0;
     virtual void deallocate(std::shared_ptr<Process> process) = 0;
-    virtual void printMem() = 0;
-    virtual void printProcesses() = 0;
-    virtual void vmstat() = 0;
+    // Called before each instruction. Returns false if the memory the
+    // instruction touches had to be brought in first (a page fault).
+    virtual bool access(const std::shared_ptr<Process>& /*process*/) { return true; }
+    // False if access() never does anything, so callers can skip it (and its lock)
+    virtual bool tracksAccesses() const { return false; };
+    // Copies the current layout out for the `memory` report
+    virtual void snapshot(MemorySnapshot& out) = 0;
+    // Reports are written to a stream so MemoryManager can render them
+    // under its lock and print them after releasing it
+    virtual void printProcesses(std::ostream& out) = 0;
+    virtual void vmstat(std::ostream& out) = 0;
+    // Page faults served and modified pages written back, for allocators that page
+    virtual int getPagedIn() { return 0; };
+    virtual int getPagedOut() { return 0; };
 };
 
 #endif //!IALLOCATOR_H
\ No newline at end of file
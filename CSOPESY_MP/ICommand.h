@@ -2,19 +2,55 @@
 #ifndef ICOMMAND_H
 #define ICOMMAND_H
 
-#include <string>
+#include <cstdint>
 
 
-enum CommandType {
-    PRINT
+enum CommandType : uint8_t {
+    PRINT,
+    DECLARE,
+    ADD,
+    SUBTRACT,
+    SLEEP,
+    FOR,
+    READ,
+    WRITE
 };
 
-class ICommand {
-public:
-    virtual void execute(int core, std::string filename) = 0;
+// Operand encoding per opcode (v = variable slot, imm = literal):
+//   PRINT     flags & PRINT_VARIABLE ? print v[a] : print the greeting
+//   DECLARE   v[a] = b
+//   ADD       v[a] = B + C          (saturates at 65535)
+//   SUBTRACT  v[a] = B - C          (saturates at 0)
+//   SLEEP     hold the core for a ticks
+//   FOR       run the next b instructions a times
+//   READ      v[a] = memory[b]
+//   WRITE     memory[a] = B
+// where B and C are v[b] / v[c], or b / c themselves when the matching
+// IMMEDIATE_ flag is set.
+enum InstructionFlags : uint8_t {
+    IMMEDIATE_B = 1,
+    IMMEDIATE_C = 2,
+    PRINT_VARIABLE = 4
+};
+
+// Size of each process's variable file; operands that name a variable are
+// taken modulo this.
+static const int VARIABLE_COUNT = 32;
+// Deepest FOR nesting the interpreter keeps frames for.
+static const int MAX_LOOP_DEPTH = 3;
 
-    int _pid;
+// One instruction of a process, stored by value in a contiguous array
+// instead of one heap object per instruction. Operands are interpreted per
+// opcode; anything derivable from the owning process (such as the PRINT
+// message) is not stored at all.
+struct Instruction {
     CommandType _type;
+    uint8_t _flags;
+    uint16_t _a;
+    uint16_t _b;
+    uint16_t _c;
 };
 
-#endif // !ICOMMAND_H
\ No newline at end of file
+static_assert(sizeof(Instruction) == 8, "Instruction should stay packed into 8 bytes");
+
+#endif // !ICOMMAND_H
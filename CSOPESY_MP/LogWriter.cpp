@@ -0,0 +1,145 @@
+#include "LogWriter.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include "Platform.h"
+
+
+// Flush early once this much output is waiting, otherwise every interval
+static const size_t FLUSH_BYTES = 1 << 20;
+static const std::chrono::milliseconds FLUSH_INTERVAL(200);
+
+LogWriter* LogWriter::_ptr = nullptr;
+
+LogWriter* LogWriter::get() {
+    return LogWriter::_ptr;
+}
+
+void LogWriter::initialize(std::string directory) {
+    LogWriter::_ptr = new LogWriter(directory);
+}
+
+void LogWriter::destroy() {
+    delete LogWriter::_ptr;
+    LogWriter::_ptr = nullptr;
+}
+
+LogWriter::LogWriter(std::string directory) : _directory(directory) {
+    Platform::makeDirectory(directory);
+}
+
+LogWriter::~LogWriter() {
+    this->stop();
+}
+
+void LogWriter::start() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (this->running == false) {
+        this->_now = time(nullptr);
+        this->running = true;
+        this->_thread = std::thread(&LogWriter::run, this);
+    }
+}
+
+void LogWriter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->running = false;
+    }
+    this->cv.notify_all();
+    if (this->_thread.joinable()) {
+        this->_thread.join();
+    }
+    // Anything pushed while the writer was on its last pass
+    std::lock_guard<std::mutex> lock(this->mtx);
+    this->writePending();
+}
+
+void LogWriter::append(const std::string& processName, int core, std::string message) {
+    if (!this->running) {
+        // With no writer thread left to flush it, a line logged after stop()
+        // is written out here rather than left in the queue
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->_lines.push(Line{ processName, core, time(nullptr), std::move(message) });
+        this->writePending();
+        return;
+    }
+
+    // Roughly the formatted size; only used to decide when to flush early
+    size_t bytes = processName.size() + message.size() + 40;
+    this->_lines.push(Line{ processName, core, this->_now.load(std::memory_order_relaxed), std::move(message) });
+    size_t pending = this->_pendingBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (pending >= FLUSH_BYTES && pending - bytes < FLUSH_BYTES) {
+        this->cv.notify_one();
+    }
+}
+
+void LogWriter::run() {
+    std::unique_lock<std::mutex> lock(this->mtx);
+    while (true) {
+        // The early wake-up is not synchronised with the push that asked for
+        // it, so a missed one only costs the rest of the interval
+        this->cv.wait_for(lock, FLUSH_INTERVAL, [this]() {
+            return !this->running || this->_pendingBytes >= FLUSH_BYTES;
+            });
+        bool stopping = !this->running;
+        this->_now = time(nullptr);
+        this->_pendingBytes = 0;
+
+        lock.unlock();
+        this->writePending();
+        lock.lock();
+
+        if (stopping) break;
+    }
+}
+
+void LogWriter::writePending() {
+    this->_lines.drain(this->_drained);
+    if (this->_drained.empty()) return;
+
+    std::unordered_map<std::string, std::string> buffers;
+    for (const Line& line : this->_drained) {
+        // Formatting the timestamp costs more than the rest of the line, so
+        // it is only redone when the second changes
+        if (line.time != this->_stampTime) {
+            struct tm timeInfo;
+            Platform::localTime(&timeInfo, &line.time);
+            char buffer[80];
+            strftime(buffer, sizeof(buffer), "(%D %r)", &timeInfo);
+            this->_stamp = buffer;
+            this->_stampTime = line.time;
+        }
+
+        std::string& buffer = buffers[line.processName];
+        buffer += this->_stamp;
+        buffer += " Core:";
+        buffer += std::to_string(line.core);
+        buffer += " \"";
+        buffer += line.message;
+        buffer += "\"\n";
+    }
+    this->_drained.clear();
+    this->flush(buffers);
+}
+
+void LogWriter::flush(std::unordered_map<std::string, std::string>& buffers) {
+    for (auto& entry : buffers) {
+        if (entry.second.empty()) continue;
+        std::string filename = this->_directory + "/" + entry.first + ".txt";
+
+        // Logs left over from an earlier run are replaced, not appended to
+        bool first = this->_opened.insert(entry.first).second;
+        std::ofstream output(filename, first ? std::ios::out | std::ios::trunc : std::ios::out | std::ios::app);
+        if (!output.is_open()) {
+            std::cerr << filename << " failed to open" << std::endl;
+            continue;
+        }
+        if (first) {
+            output << "Process name: " << entry.first << "\n" << "Logs:\n\n";
+        }
+        output.write(entry.second.data(), entry.second.size());
+    }
+}
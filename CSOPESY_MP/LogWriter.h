@@ -0,0 +1,74 @@
+#pragma once
+#ifndef LOGWRITER_H
+#define LOGWRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "MPSCQueue.h"
+
+
+// Collects PRINT output and writes it to output/<name>.txt from its own
+// thread. CPUs only pay for a lock-free queue push; the writer thread does
+// the formatting, sorts lines into per-process buffers and opens each file
+// once per flush, however many lines it received.
+class LogWriter {
+public:
+    static LogWriter* get();
+    static void initialize(std::string directory);
+    static void destroy();
+
+    void start();
+    // Flushes everything buffered so far and stops the writer thread. Only
+    // for program exit: lines appended after this, in the window before the
+    // engine is gone, are written synchronously, one file write each
+    void stop();
+
+    void append(const std::string& processName, int core, std::string message);
+
+private:
+    LogWriter(std::string directory);
+    ~LogWriter();
+
+    // One PRINT, formatted only once it reaches the writer
+    struct Line {
+        std::string processName;
+        int core;
+        time_t time;
+        std::string message;
+    };
+
+    void run();
+    // Drains the queue and writes every line in it
+    void writePending();
+    void flush(std::unordered_map<std::string, std::string>& buffers);
+
+    static LogWriter* _ptr;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    MPSCQueue<Line> _lines;
+    std::atomic<size_t> _pendingBytes{ 0 };
+    // Refreshed by the writer each time it wakes, so appending never asks
+    // the OS for the time; a stamp is at most FLUSH_INTERVAL behind
+    std::atomic<time_t> _now{ 0 };
+
+    // Writer thread only, or whoever holds mtx once it has stopped
+    std::string _directory;
+    std::unordered_set<std::string> _opened;
+    std::vector<Line> _drained;
+    time_t _stampTime = 0;
+    std::string _stamp;
+
+    std::thread _thread;
+    std::atomic<bool> running{ false };
+};
+
+#endif // !LOGWRITER_H
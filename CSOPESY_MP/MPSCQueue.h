@@ -0,0 +1,67 @@
+#pragma once
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <vector>
+
+
+// Lock-free multi-producer / single-consumer queue. Producers push with a
+// single CAS onto an intrusive stack; the consumer detaches the whole stack
+// with one exchange and reverses it, so items come out in push order and
+// there is no ABA hazard (nodes are never popped one at a time).
+template <typename T>
+class MPSCQueue {
+public:
+    MPSCQueue() = default;
+    ~MPSCQueue() {
+        std::vector<T> leftover;
+        this->drain(leftover);
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // Returns true if the queue was empty before this push, i.e. the caller
+    // is the one that should wake the consumer.
+    bool push(T item) {
+        Node* node = new Node{ std::move(item), this->_head.load(std::memory_order_relaxed) };
+        while (!this->_head.compare_exchange_weak(node->next, node,
+            std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        return node->next == nullptr;
+    }
+
+    // Consumer only. Appends everything pushed so far to out, oldest first.
+    size_t drain(std::vector<T>& out) {
+        Node* node = this->_head.exchange(nullptr, std::memory_order_acquire);
+        Node* reversed = nullptr;
+        while (node != nullptr) {
+            Node* next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+        size_t count = 0;
+        while (reversed != nullptr) {
+            Node* next = reversed->next;
+            out.push_back(std::move(reversed->item));
+            delete reversed;
+            reversed = next;
+            count++;
+        }
+        return count;
+    }
+
+    bool empty() const { return this->_head.load(std::memory_order_acquire) == nullptr; };
+
+private:
+    struct Node {
+        T item;
+        Node* next;
+    };
+
+    std::atomic<Node*> _head{ nullptr };
+};
+
+#endif // !MPSCQUEUE_H
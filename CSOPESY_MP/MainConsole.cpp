@@ -10,10 +10,12 @@
 #include "AConsole.h"
 #include "Config.h"
 #include "ConsoleManager.h"
-#include "Cpu.h"
+#include "CPU.h"
+#include "EventEngine.h"
 #include "MainConsole.h"
 #include "MarqueeConsole.h"
 #include "MemoryManager.h"
+#include "Platform.h"
 #include "PrintCommand.h"
 #include "Scheduler.h"
 
@@ -64,11 +66,28 @@ MainConsole::MainConsole(ConsoleManager* conman) : AConsole("MAIN_CONSOLE"), _co
 		std::cout << "root:\\> Report generated at root:/csopesy-log.txt\n";
 		};
 	this->_commandMap["scheduler-test"] = [conman](argType arguments) {
-		conman->_scheduler->schedulerTest();
+		// optional: scheduler-test <count> stops after count processes
+		int count = -1;
+		if (!arguments.empty() && arguments.at(0) != "scheduler-test") {
+			count = 0;
+			try {
+				count = std::stoi(arguments.at(0));
+			}
+			catch (const std::exception&) {}
+			if (count <= 0) {
+				std::cout << "Invalid process count." << std::endl;
+				return;
+			}
+		}
+		std::cout << "Started adding processes." << std::endl;
+		conman->_scheduler->schedulerTest(count);
 		};
 	this->_commandMap["scheduler-stop"] = [conman](argType arguments) {
 		conman->_scheduler->schedulerTestStop();
 		};
+	this->_commandMap["scheduler-stats"] = [conman](argType arguments) {
+		conman->_scheduler->printStats();
+		};
 	this->_commandMap["memory"] = [conman](argType arguments) {
 		conman->_scheduler->printMem();
 		};
@@ -86,47 +105,22 @@ void MainConsole::run() {
 		std::cout << "root:\\> ";
 		getline(std::cin, input);
 		if (input == "initialize") {
-			this->_initialized = true;
-			this->_conman->newConsole("MARQUEE_CONSOLE", std::make_shared<MarqueeConsole>(144));
-
 			Config config = Config();
-			config.initialize();
-
-			if (config.getMinPageProc() != 1 && config.getMaxPageProc() != 1) {
-				Process::setRequiredMemory(config.getMinMemProc(), config.getMaxMemProc());
-			}
-
-			Scheduler::initialize(config.getNumCpu(),
-				config.getBatchProcessFreq(),
-				config.getMinIns(), config.getMaxIns(),
-				config.getMinMemProc(), config.getMaxMemProc(),
-				config.getMaxMem(), config.getMinPageProc(), config.getMaxPageProc());
-
-			Scheduler* sched = Scheduler::get();
-
-			this->_conman->_scheduler = sched;
-
-			PrintCommand::setMsDelay(0);
-			CPU::setMsDelay(config.getDelaysPerExec() * 100);
-
-			std::string schedType = config.getScheduler();
-			if (schedType == "fcfs") {
-				sched->startFCFS(config.getDelaysPerExec());
-			}
-			else if (schedType == "sjf") {
-				sched->startSJF(config.getDelaysPerExec(), config.isPreemptive());
-			}
-			else if (schedType == "rr") {
-				sched->startRR(config.getDelaysPerExec(), config.getQuantumCycle());
+			if (!config.initialize() || !Scheduler::startSimulation(config)) {
+				continue;
 			}
+			this->_initialized = true;
+			this->_conman->newConsole("MARQUEE_CONSOLE", std::make_shared<MarqueeConsole>(144));
+			this->_conman->_scheduler = Scheduler::get();
 
 		}
 		if (input == "exit") {
 			this->stop();
+			Scheduler::stopSimulation();
 			return;
 		}
 	}
-	system("cls");
+	Platform::clearScreen();
 	this->_active = true;
 	this->printHeader();
 	while (this->_active) {
@@ -136,6 +130,9 @@ void MainConsole::run() {
 		input.erase(0, input.find(SPACE) + 1);
 		if (command == "exit") {
 			this->stop();
+			// stop() also runs on every switch to a screen or the marquee, so
+			// the simulation (and its log writers) only shuts down here
+			Scheduler::stopSimulation();
 			return;
 		}
 		if (this->_commandMap.find(command) == this->_commandMap.end())
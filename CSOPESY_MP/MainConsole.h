@@ -3,7 +3,6 @@
 #define MAINCONSOLE_H
 
 #include "AConsole.h"
-#include "ConsoleManager.h"
 #include <functional>
 #include <memory>
 #include <string>
@@ -12,6 +11,9 @@
 
 typedef const std::vector<std::string>& argType;
 
+// ConsoleManager.h includes this header
+class ConsoleManager;
+
 
 class MainConsole : public AConsole {
 public:
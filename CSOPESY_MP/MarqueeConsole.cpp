@@ -1,7 +1,8 @@
 #include "AConsole.h"
 #include "MarqueeConsole.h"
+#include "Platform.h"
+#include <algorithm>
 #include <chrono>
-#include <conio.h>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
@@ -30,8 +31,8 @@ void MarqueeConsole::run() {
 	outputThread.detach();
 
 	while (!this->stopFlag) {
-		if (_kbhit()) {
-			key = _getch();
+		if (Platform::keyPressed()) {
+			key = Platform::readKey();
 			if (key == DELETE) {
 				if (this->input.size() > 0) this->input.pop_back();
 			}
@@ -64,7 +65,7 @@ void MarqueeConsole::draw() {
 	bool moveLeft = false;
 
 	while (!this->stopFlag) {
-		system("cls");
+		Platform::clearScreen();
 
 		for (int i = 0; i < 41; i++) std::cout << '*';
 		std::cout << std::endl;
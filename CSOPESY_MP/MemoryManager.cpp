@@ -5,33 +5,84 @@
 #include <ctime>
 #include <sstream>
 #include <memory>
+#include <mutex>
 #include "Process.h"
+#include "BuddyAllocator.h"
 #include "FlatAllocator.h"
 #include "PagingAllocator.h"
 
-MemoryManager::MemoryManager(int maxMemory, int minPage, int maxPage) {
-	if (minPage == 1 && maxPage == 1) {
-		this->_allocator = new FlatAllocator(maxMemory);
+MemoryManager::MemoryManager(int maxMemory, int minPage, int maxPage, std::string allocator, std::string fitPolicy,
+	std::string replacement) {
+	if (allocator == "flat") {
+		this->_allocator = new FlatAllocator(maxMemory, fitPolicy);
+	}
+	else if (allocator == "buddy") {
+		this->_allocator = new BuddyAllocator(maxMemory);
 	}
 	else {
 		Process::setRequiredPages(minPage, maxPage);
-		this->_allocator = new PagingAllocator(maxMemory);
+		this->_allocator = new PagingAllocator(maxMemory, replacement);
 	}
+	this->_tracksAccesses = this->_allocator->tracksAccesses();
+}
+
+MemoryManager::~MemoryManager() {
+	delete this->_allocator;
 }
 
 bool MemoryManager::allocate(std::shared_ptr<Process> process) {
+	std::unique_lock<std::shared_mutex> lock(this->_lock);
 	return this->_allocator->allocate(process);
 }
 
 void MemoryManager::deallocate(std::shared_ptr<Process> process) {
+	std::unique_lock<std::shared_mutex> lock(this->_lock);
 	this->_allocator->deallocate(process);
 }
 
-void MemoryManager::printMem(int qq) {
-	this->_allocator->printMem();
+// Runs every tick; contiguous allocators have nothing to do here, so they
+// cost no lock
+bool MemoryManager::access(const std::shared_ptr<Process>& process) {
+	if (!this->_tracksAccesses) return true;
+	std::unique_lock<std::shared_mutex> lock(this->_lock);
+	return this->_allocator->access(process);
+}
+
+void MemoryManager::snapshot(MemorySnapshot& out) {
+	{
+		std::shared_lock<std::shared_mutex> lock(this->_lock);
+		this->_allocator->snapshot(out);
+	}
+	out.timestamp = time(nullptr);
+}
+
+void MemoryManager::printMem(std::ostream& out) {
+	MemorySnapshot snapshot;
+	this->snapshot(snapshot);
+	snapshot.print(out);
+}
+
+void MemoryManager::printProcesses(std::ostream& out) {
+	std::ostringstream snapshot;
+	{
+		std::shared_lock<std::shared_mutex> lock(this->_lock);
+		this->_allocator->printProcesses(snapshot);
+	}
+	out << snapshot.str();
 }
 
-void MemoryManager::vmstat() {
-	this->_allocator->vmstat();
+void MemoryManager::getPageCounts(int& pagedIn, int& pagedOut) {
+	std::shared_lock<std::shared_mutex> lock(this->_lock);
+	pagedIn = this->_allocator->getPagedIn();
+	pagedOut = this->_allocator->getPagedOut();
+}
+
+void MemoryManager::vmstat(std::ostream& out) {
+	std::ostringstream snapshot;
+	{
+		std::shared_lock<std::shared_mutex> lock(this->_lock);
+		this->_allocator->vmstat(snapshot);
+	}
+	out << snapshot.str();
 }
 
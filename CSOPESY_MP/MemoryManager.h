@@ -6,25 +6,31 @@
 #include <unordered_map>
 #include "Process.h"
 #include <memory>
+#include <shared_mutex>
 #include "IAllocator.h"
 
 class MemoryManager {
 public:
-    MemoryManager(int maxMemory, int minPage, int maxPage);
-    ~MemoryManager() = default;
+    MemoryManager(int maxMemory, int minPage, int maxPage, std::string allocator, std::string fitPolicy,
+        std::string replacement);
+    ~MemoryManager();
 
+    // Safe from any thread. Changes take the lock exclusively; reports take it
+    // shared only while copying or rendering state, and write out after release
     bool allocate(std::shared_ptr<Process> process);
     void deallocate(std::shared_ptr<Process> process);
+    bool access(const std::shared_ptr<Process>& process);
 
-    void printMem(int qq);
-    void vmstat();
-
-    IAllocator* getAllocator() {
-        return this->_allocator;
-    }
+    void snapshot(MemorySnapshot& out);
+    void printMem(std::ostream& out);
+    void printProcesses(std::ostream& out);
+    void vmstat(std::ostream& out);
+    void getPageCounts(int& pagedIn, int& pagedOut);
 
 private:
     IAllocator* _allocator;
+    bool _tracksAccesses;
+    std::shared_mutex _lock;
 };
 
 #endif // !MEMORYMANAGER_H
\ No newline at end of file
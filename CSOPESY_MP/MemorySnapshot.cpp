@@ -0,0 +1,29 @@
+#include "MemorySnapshot.h"
+#include "Platform.h"
+
+#include <string>
+
+
+void MemorySnapshot::print(std::ostream& out) const {
+	struct tm timeInfo;
+	Platform::localTime(&timeInfo, &this->timestamp);
+	char buffer[80];
+	strftime(buffer, sizeof(buffer), "Timestamp: (%D %r)", &timeInfo);
+
+	std::string output = std::string(buffer) + "\n"
+		+ "Number of processes in memory: " + std::to_string(this->processCount) + "\n"
+		+ "Total external fragmentation in KB: " + std::to_string(this->externalFragmentation) + "\n";
+	if (this->internalFragmentation >= 0) {
+		output += "Total internal fragmentation in KB: " + std::to_string(this->internalFragmentation) + "\n";
+	}
+	output += "\n-----end----- = " + std::to_string(this->maxMemory) + "\n\n";
+
+	// Highest addresses are printed first
+	for (auto block = this->blocks.rbegin(); block != this->blocks.rend(); block++) {
+		output += std::to_string(block->end) + "\n"
+			+ block->process->getName() + "\n"
+			+ std::to_string(block->start) + "\n\n";
+	}
+	output += "----start---- = 0";
+	out << output << std::endl;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#ifndef MEMORYSNAPSHOT_H
+#define MEMORYSNAPSHOT_H
+
+#include "Process.h"
+
+#include <ctime>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+
+// Copy of an allocator's layout. Taking one only copies block bounds and
+// process pointers, so it is cheap under the memory lock; formatting it into
+// the `memory` report happens afterwards, on whichever thread prints it.
+struct MemorySnapshot {
+    struct Block {
+        int start;
+        int end;
+        std::shared_ptr<Process> process;
+    };
+
+    time_t timestamp = 0;
+    int maxMemory = 0;
+    int processCount = 0;
+    int externalFragmentation = 0;
+    // -1 for allocators that hand out exactly what was asked for
+    int internalFragmentation = -1;
+    // Ascending by address
+    std::vector<Block> blocks;
+
+    void print(std::ostream& out) const;
+};
+
+#endif // !MEMORYSNAPSHOT_H
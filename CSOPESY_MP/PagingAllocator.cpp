@@ -8,178 +8,236 @@
 #include <memory>
 #include <sstream>
 #include <string>
-#include <tuple>
 #include <unordered_map>
-#include <utility>
-#include <queue>
 #include "Scheduler.h"
 #include <iomanip>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 
 #define PAGE_SIZE 4;
 
-PagingAllocator::PagingAllocator(int maxMemory) : _maxMemory(maxMemory) {
+// Index of the lowest set bit; word must not be 0
+static int lowestBit(uint64_t word) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return int(index);
+#else
+	return __builtin_ctzll(word);
+#endif
+}
+
+PagingAllocator::PagingAllocator(int maxMemory, std::string replacement) : _maxMemory(maxMemory) {
 	std::ofstream backingStoreFile(".pagefile", std::ios::trunc);
 	backingStoreFile.close();
 	int requiredMem = Process::setRequiredMemory(-1, -1);
-	for (size_t i = 0; i < maxMemory / (requiredMem / Process::getRequiredPages()); i++) {
-		_freeFrameList.push(i);
+	int frameCount = maxMemory / (requiredMem / Process::getRequiredPages());
+	_frames.resize(frameCount);
+	_freeBitmap.resize((frameCount + 63) / 64, 0);
+	for (int i = 0; i < frameCount; i++) {
+		this->freeFrame(i);
 	}
+	_replacement = IReplacementPolicy::create(replacement, frameCount);
+}
+
+PagingAllocator::~PagingAllocator() {
+	delete _replacement;
 }
 
+// Pages are only loaded when first touched, so admitting a process just
+// gives it an empty page table
 bool PagingAllocator::allocate(std::shared_ptr<Process> process) {
-	int requiredMem = Process::setRequiredMemory(0, 0);
-	int requiredPages = Process::getRequiredPages();
-	int pageSize = requiredMem / requiredPages;
-	if (_pageTable.find(process->getName()) != _pageTable.end()) {
-		for (size_t i = 0; i < _pageTable[process->getName()].size(); i++) {
-			if (_pageTable[process->getName()].at(i) < 0) {
-				int nextFrame = _freeFrameList.front();
-				_freeFrameList.pop();
-				_pageTable[process->getName()].at(i) = nextFrame;
-			}
-		}
-		return true;
+	int pid = process->getID();
+	if (pid >= int(_pageTables.size())) {
+		_pageTables.resize(pid + 1);
+		_owners.resize(pid + 1);
 	}
-	if (_freeFrameList.size() >= requiredPages) {
-		for (size_t i = 0; i < requiredPages; i++) {
-			int nextFrame = _freeFrameList.front();
-			_freeFrameList.pop();
-			_pageTable[process->getName()].push_back(nextFrame);
-			_pagedIn++;
-		}
-		return true;
+	if (_pageTables[pid].empty()) {
+		_pageTables[pid].resize(Process::getRequiredPages(), -1);
+		_owners[pid] = process;
+		_processCount++;
 	}
-	return false;
+	return true;
 }
 
 void PagingAllocator::deallocate(std::shared_ptr<Process> process) {
-	if (_pageTable.find(process->getName()) != _pageTable.end()) {
-		for (size_t i = 0; i < _pageTable[process->getName()].size(); i++) {
-			_freeFrameList.push(_pageTable[process->getName()].at(i));
-			_pagedOut++;
+	int pid = process->getID();
+	if (pid < int(_pageTables.size()) && !_pageTables[pid].empty()) {
+		std::vector<int>& pages = _pageTables[pid];
+		for (size_t i = 0; i < pages.size(); i++) {
+			if (pages[i] >= 0) {
+				_replacement->freed(pages[i]);
+				this->freeFrame(pages[i]);
+			}
 		}
-		_pageTable.erase(_pageTable.find(process->getName()));
+		// Release the storage too; finished PIDs are never reused
+		std::vector<int>().swap(pages);
+		_owners[pid] = nullptr;
+		_processCount--;
 	}
 }
 
-void PagingAllocator::printMem() {
-	auto timestamp = time(nullptr);
-	struct tm timeInfo;
-	localtime_s(&timeInfo, &timestamp);
-	char buffer[80];
-	strftime(buffer, sizeof(buffer), "Timestamp: (%D %r)", &timeInfo);
+bool PagingAllocator::access(const std::shared_ptr<Process>& process) {
+	int pid = process->getID();
+	if (pid >= int(_pageTables.size()) || _pageTables[pid].empty()) {
+		return true;
+	}
+	std::vector<int>& pages = _pageTables[pid];
+	int codePage, dataPage;
+	bool write;
+	process->getNextAccess(int(pages.size()), codePage, dataPage, write);
+	bool hit = true;
+	if (codePage >= 0) {
+		hit = this->touch(pid, pages, codePage, false) && hit;
+	}
+	// The code page stays pinned while the data page comes in, so one fault
+	// leaves both resident instead of trading one for the other forever
+	if (dataPage >= 0) {
+		hit = this->touch(pid, pages, dataPage, write, codePage >= 0 ? pages[codePage] : -1) && hit;
+	}
+	return hit;
+}
 
-	int requiredMem = Process::setRequiredMemory(0, 0);
-	int requiredPages = Process::getRequiredPages();
-	int pageSize = requiredMem / requiredPages;
+bool PagingAllocator::touch(int pid, std::vector<int>& pages, int page, bool write, int pinned) {
+	int frame = pages.at(page);
+	if (frame >= 0) {
+		_frames[frame].referenced = true;
+		_frames[frame].dirty = _frames[frame].dirty || write;
+		_replacement->accessed(frame);
+		return true;
+	}
 
-	std::vector<std::string> memProcNames;
-	std::vector<int> memFrameIdx;
-
-	for (auto it = _pageTable.begin(); it != _pageTable.end(); ++it) {
-		std::string process = it->first;
-		for (size_t i = 0; i < it->second.size(); i++) {
-			if (it->second.at(i) != -1) {
-				int insertIdx = 0;
-				for (size_t j = 0; j < memFrameIdx.size(); j++) {
-					if (memFrameIdx.at(j) > it->second.at(i)) {
-						insertIdx = j;
-						break;
-					}
-				}
-				memFrameIdx.insert(memFrameIdx.begin() + insertIdx, it->second.at(i));
-				memProcNames.insert(memProcNames.begin() + insertIdx, process);
-			}
+	// Page fault
+	frame = this->takeFrame(pinned);
+	if (frame < 0) {
+		// No frames at all; nothing to wait for
+		return true;
+	}
+	pages[page] = frame;
+	Frame& entry = _frames[frame];
+	entry.pid = pid;
+	entry.page = page;
+	entry.referenced = true;
+	entry.dirty = write;
+	_replacement->loaded(frame);
+	_pagedIn++;
+	return false;
+}
+
+int PagingAllocator::takeFrame(int pinned) {
+	if (_freeCount > 0) {
+		while (_freeBitmap[_freeHint] == 0) {
+			_freeHint++;
 		}
+		int frame = int(_freeHint * 64) + lowestBit(_freeBitmap[_freeHint]);
+		_freeBitmap[_freeHint] &= ~(uint64_t(1) << (frame % 64));
+		_freeCount--;
+		return frame;
 	}
-	std::cout << std::string(buffer) + "\n"
-		+ "Number of processes in memory: " + std::to_string(_pageTable.size()) + "\n"
-		+ "Total external fragmentation in KB: " + std::to_string(this->_maxMemory - memFrameIdx.size() * pageSize) + "\n"
-		+ "\n"
-		+ "-----end----- = " + std::to_string(this->_maxMemory) + "\n"
-		+ "\n";
 
-	std::vector<std::pair<int, std::string>> sortVector;
-	for (size_t i = 0; i < memFrameIdx.size(); ++i) {
-		sortVector.emplace_back(memFrameIdx[i], memProcNames[i]);
+	IReplacementPolicy::ReferenceTest testAndClear = [this](int frame) {
+		bool referenced = _frames[frame].referenced;
+		_frames[frame].referenced = false;
+		return referenced;
+		};
+	int victim = _replacement->chooseVictim(testAndClear);
+	if (victim >= 0 && victim == pinned) {
+		// Pick again, then let the policy track the pinned frame once more
+		victim = _replacement->chooseVictim(testAndClear);
+		_replacement->loaded(pinned);
+	}
+	if (victim < 0) {
+		return -1;
 	}
+	// Only modified pages have to be written back
+	Frame& entry = _frames[victim];
+	if (entry.dirty) {
+		_pagedOut++;
+	}
+	_pageTables[entry.pid][entry.page] = -1;
+	entry = Frame();
+	return victim;
+}
 
-	std::sort(sortVector.begin(), sortVector.end(), std::greater<>());
+void PagingAllocator::freeFrame(int frame) {
+	_frames[frame] = Frame();
+	_freeBitmap[frame / 64] |= uint64_t(1) << (frame % 64);
+	if (size_t(frame / 64) < _freeHint) {
+		_freeHint = frame / 64;
+	}
+	_freeCount++;
+}
 
+void PagingAllocator::snapshot(MemorySnapshot& out) {
+	int requiredMem = Process::setRequiredMemory(0, 0);
+	int requiredPages = Process::getRequiredPages();
+	int pageSize = requiredMem / requiredPages;
 
-	for (size_t i = 0; i < sortVector.size(); i++) {
-		std::cout << std::to_string((sortVector[i].first + 1) * pageSize) << std::endl
-			<< sortVector[i].second << std::endl
-			<< std::to_string(sortVector[i].first * pageSize)
-			<< std::endl << std::endl;
+	int usedFrames = int(_frames.size()) - _freeCount;
+	out.maxMemory = this->_maxMemory;
+	out.processCount = _processCount;
+	out.externalFragmentation = this->_maxMemory - usedFrames * pageSize;
+	out.blocks.reserve(usedFrames);
+	for (int frame = 0; frame < int(_frames.size()); frame++) {
+		if (_frames[frame].pid < 0) continue;
+		out.blocks.push_back({ frame * pageSize, (frame + 1) * pageSize, _owners[_frames[frame].pid] });
 	}
-	std::cout << "----start---- = 0" << std::endl;
 }
 
-void PagingAllocator::printProcesses() {
+void PagingAllocator::printProcesses(std::ostream& out) {
 	int requiredMem = Process::setRequiredMemory(0, 0);
 	int requiredPages = Process::getRequiredPages();
 	int pageSize = requiredMem / requiredPages;
 
+	// Pages load on demand, so only resident frames count, as in vmstat. The
+	// total comes from the frame table and each process's share from its
+	// page table, so the two cross-check each other.
 	std::vector<std::string> memProcNames;
-	std::vector<int> memFrameIdx;
+	std::vector<int> memResident;
 
-	for (auto it = _pageTable.begin(); it != _pageTable.end(); ++it) {
-		std::string process = it->first;
-		memProcNames.push_back(process);
+	for (size_t pid = 0; pid < _pageTables.size(); pid++) {
+		if (!_pageTables[pid].empty()) {
+			int resident = 0;
+			for (size_t page = 0; page < _pageTables[pid].size(); page++) {
+				if (_pageTables[pid][page] >= 0) resident++;
+			}
+			memProcNames.push_back(_owners[pid]->getName());
+			memResident.push_back(resident * pageSize);
+		}
 	}
 
-	std::cout << "Memory Usage: " << this->_pageTable.size() * requiredMem << " / " << this->_maxMemory << std::endl;
+	int used = (int(_frames.size()) - _freeCount) * pageSize;
+	out << "Memory Usage: " << used << " / " << this->_maxMemory << std::endl;
 
-	std::cout << "Memory Util: " << (1.0 * (this->_pageTable.size() * requiredMem) / this->_maxMemory) * 100 << "%" << std::endl;
+	out << "Memory Util: " << (1.0 * used / this->_maxMemory) * 100 << "%" << std::endl;
 
-	std::cout << std::endl;
+	out << std::endl;
 
 	for (int i = 0; i < 48; i++) {
-		std::cout << "=";
+		out << "=";
 	}
-	std::cout << std::endl;
+	out << std::endl;
 
-	std::cout << "Running processes and memory usage: " << std::endl;
+	out << "Running processes and memory usage: " << std::endl;
 
 	for (int i = 0; i < 48; i++) {
-		std::cout << "-";
+		out << "-";
 	}
-	std::cout << std::endl;
+	out << std::endl;
 
 	for (size_t i = 0; i < memProcNames.size(); i++)
 	{
-		std::cout << memProcNames[i] << " " << requiredPages * pageSize << std::endl;
+		out << memProcNames[i] << " " << memResident[i] << std::endl;
 	}
 }
 
-void PagingAllocator::vmstat() {
+void PagingAllocator::vmstat(std::ostream& out) {
 	int requiredMem = Process::setRequiredMemory(0, 0);
 	int requiredPages = Process::getRequiredPages();
 	int pageSize = requiredMem / requiredPages;
-	int used = 0;
-	int active = 0;
-	if (_pageTable.size() > 0) {
-		int first = _maxMemory;
-		int last = 0;
-		for (auto it = _pageTable.begin(); it != _pageTable.end(); ++it) {
-			std::string process = it->first;
-			for (size_t i = 0; i < it->second.size(); i++) {
-				if (it->second.at(i) != -1) {
-					if (it->second[i] * pageSize < first) {
-						first = it->second[i] * pageSize;
-					}
-					if ((it->second[i] + 1) * pageSize > last) {
-						last = (it->second[i] + 1) * pageSize;
-					}
-					active += pageSize;
-				}
-			}
-
-		}
-		used = last - first;
-	}
+	int active = (int(_frames.size()) - _freeCount) * pageSize;
 
 	int totalTicks = Scheduler::get()->getTotalTicks();
 	int inactiveTicks = Scheduler::get()->getInactiveTicks();
@@ -211,6 +269,6 @@ void PagingAllocator::vmstat() {
 	keys.push_back("num paged out");
 	for (size_t i = 0; i < keys.size(); i++) {
 		std::string key = keys[i];
-		std::cout << std::setw(padding + 5) << statMap[key] << " " << key << std::endl;
+		out << std::setw(padding + 5) << statMap[key] << " " << key << std::endl;
 	}
 }
@@ -3,25 +3,52 @@
 #define PAGINGALLOCATOR_H
 
 #include "IAllocator.h"
-#include <queue>
-#include <unordered_map>
+#include "ReplacementPolicy.h"
+#include <cstdint>
+#include <string>
+#include <vector>
 
 class PagingAllocator : public IAllocator {
 public:
-    PagingAllocator(int maxMemory);
-    ~PagingAllocator() = default;
+    PagingAllocator(int maxMemory, std::string replacement);
+    ~PagingAllocator();
 
     bool allocate(std::shared_ptr<Process> process) override;
     void deallocate(std::shared_ptr<Process> process) override;
+    bool access(const std::shared_ptr<Process>& process) override;
+    bool tracksAccesses() const override { return true; };
 
-    void printMem() override;
-    void printProcesses() override;
-    void vmstat() override;
+    void snapshot(MemorySnapshot& out) override;
+    void printProcesses(std::ostream& out) override;
+    void vmstat(std::ostream& out) override;
+    int getPagedIn() override { return _pagedIn; };
+    int getPagedOut() override { return _pagedOut; };
 
 private:
-    std::queue<int> _freeFrameList;
-    // procName > vector(page number)[frame]
-    std::unordered_map <std::string, std::vector<int>> _pageTable;
+    // One entry per physical frame; pid is -1 while the frame is free
+    struct Frame {
+        int pid = -1;
+        int page = -1;
+        bool referenced = false;
+        bool dirty = false;
+    };
+
+    // pinned (if not -1) is a frame the fault must not evict
+    bool touch(int pid, std::vector<int>& pages, int page, bool write, int pinned = -1);
+    int takeFrame(int pinned);
+    void freeFrame(int frame);
+
+    std::vector<Frame> _frames;
+    // Bit set per free frame, scanned from the lowest word that can hold one
+    std::vector<uint64_t> _freeBitmap;
+    size_t _freeHint = 0;
+    int _freeCount = 0;
+    // PID > vector(page number)[frame, or -1]; empty while the process has no pages
+    std::vector<std::vector<int>> _pageTables;
+    // PID > process, only needed for names when printing
+    std::vector<std::shared_ptr<Process>> _owners;
+    int _processCount = 0;
+    IReplacementPolicy* _replacement;
     int _maxMemory;
     int _pagedIn = 0;
     int _pagedOut = 0;
@@ -0,0 +1,88 @@
+#include "Platform.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#ifdef _WIN32
+#include <conio.h>
+#include <windows.h>
+#else
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+void Platform::makeDirectory(const std::string& path) {
+#ifdef _WIN32
+    CreateDirectoryA(path.c_str(), NULL);
+#else
+    mkdir(path.c_str(), 0755);
+#endif
+}
+
+void Platform::localTime(struct tm* out, const time_t* time) {
+#ifdef _WIN32
+    localtime_s(out, time);
+#else
+    localtime_r(time, out);
+#endif
+}
+
+void Platform::clearScreen() {
+#ifdef _WIN32
+    system("cls");
+#else
+    std::cout << "\033[2J\033[H" << std::flush;
+#endif
+}
+
+void Platform::setCursorPosition(short row, short col) {
+#ifdef _WIN32
+    HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+    COORD coord = { col, row };
+    SetConsoleCursorPosition(handle, coord);
+#else
+    std::cout << "\033[" << row + 1 << ";" << col + 1 << "H";
+#endif
+}
+
+std::tuple<short, short> Platform::getWindowSize() {
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
+    short width = csbi.srWindow.Right - csbi.srWindow.Left + 1;
+    short height = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+    return std::make_tuple(width, height);
+#else
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_col == 0) {
+        return std::make_tuple(short(80), short(25));
+    }
+    return std::make_tuple(short(size.ws_col), short(size.ws_row));
+#endif
+}
+
+bool Platform::keyPressed() {
+#ifdef _WIN32
+    return _kbhit() != 0;
+#else
+    struct pollfd input = { STDIN_FILENO, POLLIN, 0 };
+    return poll(&input, 1, 0) > 0;
+#endif
+}
+
+int Platform::readKey() {
+#ifdef _WIN32
+    return _getch();
+#else
+    // The terminal stays in line mode, so keys arrive once Enter is pressed
+    unsigned char key = 0;
+    if (read(STDIN_FILENO, &key, 1) != 1) return 0;
+    if (key == '\n') return 13;
+    if (key == 127) return 8;
+    return key;
+#endif
+}
@@ -0,0 +1,30 @@
+#pragma once
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <ctime>
+#include <string>
+#include <tuple>
+
+
+// The few OS calls the simulator makes, so the rest of the code builds on
+// Windows and on POSIX systems alike.
+class Platform {
+public:
+    // Creates one directory level; an existing directory is not an error
+    static void makeDirectory(const std::string& path);
+    // Same argument order as MSVC's localtime_s
+    static void localTime(struct tm* out, const time_t* time);
+
+    static void clearScreen();
+    static void setCursorPosition(short row, short col);
+    // (columns, rows) of the terminal
+    static std::tuple<short, short> getWindowSize();
+
+    // Non-blocking key polling for the marquee console. Keys come back
+    // Windows style: 13 for Enter, 8 for Backspace.
+    static bool keyPressed();
+    static int readKey();
+};
+
+#endif // !PLATFORM_H
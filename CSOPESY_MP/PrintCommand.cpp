@@ -1,8 +1,6 @@
 #include "PrintCommand.h"
+#include "LogWriter.h"
 #include <chrono>
-#include <ctime>
-#include <fstream>
-#include <iostream>
 #include <string>
 #include <thread>
 
@@ -11,28 +9,21 @@ typedef std::string String;
 
 int PrintCommand::msDelay = 50;
 
-void PrintCommand::execute(int core, String filename) {
-    //std::ofstream output;
-    //output.open(filename, std::ios::out | std::ios::app);
-
-    //// output folder must exist!!!
-    //if (output.is_open()) {
-    //    auto timestamp = time(nullptr);
-    //    struct tm timeInfo;
-    //    localtime_s(&timeInfo, &timestamp);
-    //    char buffer[80];
-    //    strftime(buffer, sizeof(buffer), "(%D %r)", &timeInfo);
+void PrintCommand::execute(int core, const String& processName, int variable, int value) {
+    LogWriter* log = LogWriter::get();
+    if (log != nullptr) {
+        log->append(processName, core, PrintCommand::getMessage(processName, variable, value));
+    }
+    if (PrintCommand::msDelay > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(PrintCommand::msDelay));
+    }
+}
 
-    //    output << buffer << " "
-    //        << "Core:" << core << " "
-    //        << "\"" << this->_message << "\""
-    //        << std::endl;
-    //    output.close();
-    //}
-    //else {
-    //    std::cerr << filename << " failed to open" << std::endl;
-    //}
-    std::this_thread::sleep_for(std::chrono::milliseconds(PrintCommand::msDelay));
+String PrintCommand::getMessage(const String& processName, int variable, int value) {
+    if (variable >= 0) {
+        return "Value from v" + std::to_string(variable) + ": " + std::to_string(value);
+    }
+    return "Hello world from " + processName + "!";
 }
 
 void PrintCommand::setMsDelay(int delay) {
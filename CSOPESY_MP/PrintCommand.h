@@ -6,22 +6,18 @@
 #include <string>
 
 
-class PrintCommand : public ICommand {
+// Behaviour of the PRINT instruction. Instructions carry no message of
+// their own; it is built from the process name (or the printed variable)
+// only when it is needed, and handed to the LogWriter if one is running.
+class PrintCommand {
 public:
-    PrintCommand(std::string message, int pid) : _message(message), _pid(pid) {};
-    ~PrintCommand() = default;
-
-    void execute(int core, std::string output);
+    static void execute(int core, const std::string& processName, int variable = -1, int value = 0);
+    static std::string getMessage(const std::string& processName, int variable = -1, int value = 0);
 
     static void setMsDelay(int delay);
 
-    int _pid;
-    CommandType _type = PRINT;
-
-    std::string _message;
-
 private:
     static int msDelay;
 };
 
-#endif // !PRINTCOMMAND_H
\ No newline at end of file
+#endif // !PRINTCOMMAND_H
@@ -1,13 +1,14 @@
 #include "Process.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
-#include <windows.h>
 
 #include "PrintCommand.h"
-#include <mutex>
+#include "ProgramGenerator.h"
+#include "Random.h"
 #include <random>
 
 typedef std::string String;
@@ -19,23 +20,30 @@ Process::Process(String name, std::uniform_int_distribution<int> commandDistr,
     std::uniform_int_distribution<int> memoryDistr,
     std::uniform_int_distribution<int> pageDistr) : _name(name) {
 
-    std::lock_guard<std::mutex> lock(mtx);
-    this->_pid = Process::nextID;
-    Process::nextID++;
-    std::random_device rand_dev;
-    std::mt19937 generator(rand_dev());
+    this->_pid = Process::nextID++;
+    std::mt19937 generator = Random::generator(Random::PROCESS, this->_pid);
     int numCommands = commandDistr(generator);
-    for (int i = 0; i < numCommands; i++) {
-        this->_commandList.push_back(
-            std::make_shared<PrintCommand>(
-                "Hello world from " + this->_name + "!", this->_pid
-            )
-        );
-    }
+    int memory = memoryDistr(generator);
+    this->build(numCommands, memory);
+}
+
+Process::Process(String name, int instructions, int memory) : _name(name) {
+    this->_pid = Process::nextID++;
+    this->build(instructions, memory);
+}
+
+// The program comes from its own per-PID stream, so a replayed process with
+// the same PID and seed runs the same instructions as the recorded one
+void Process::build(int instructions, int memory) {
+    std::mt19937 generator = Random::generator(Random::PROGRAM, this->_pid);
+    ProgramGenerator::generate(instructions, generator, this->_instructions);
+    this->_totalInstructions = instructions;
+    this->_remainingBurst = instructions;
+    this->_finished = this->_instructions.empty();
+    this->_requestedMemory = memory;
     if (Process::sameMemory == -1) {
-        this->_requiredMemory = memoryDistr(generator);
         int power = 1;
-        while (power < this->_requiredMemory) {
+        while (power < memory) {
             power *= 2;
         }
         this->_requiredMemory = power;
@@ -45,26 +53,124 @@ Process::Process(String name, std::uniform_int_distribution<int> commandDistr,
     }
 }
 
-void Process::execute() {
-    std::lock_guard<std::mutex> lock(mtx);
-    if (!this->hasFinished()) {
-        this->_commandList.at(_commandCounter)->execute(this->_cpuCoreID, ".\\output\\" + this->_name + ".txt");
-        this->_commandCounter++;
+bool Process::execute() {
+    if (this->hasFinished()) return false;
+
+    // A sleeping process keeps its core but retires nothing
+    if (this->_sleepTicks > 0) {
+        if (--this->_sleepTicks == 0 && this->_pc >= int(this->_instructions.size())) {
+            this->_finished.store(true, std::memory_order_release);
+        }
+        return false;
+    }
+
+    const Instruction& instruction = this->_instructions[this->_pc];
+    uint16_t* variables = this->_variables;
+    int next = this->_pc + 1;
+    switch (instruction._type) {
+    case PRINT:
+        if (instruction._flags & PRINT_VARIABLE) {
+            int index = instruction._a % VARIABLE_COUNT;
+            PrintCommand::execute(this->_cpuCoreID, this->_name, index, variables[index]);
+        }
+        else {
+            PrintCommand::execute(this->_cpuCoreID, this->_name);
+        }
+        break;
+    case DECLARE:
+        variables[instruction._a % VARIABLE_COUNT] = instruction._b;
+        break;
+    case ADD: {
+        int sum = this->readOperand(instruction, IMMEDIATE_B, instruction._b)
+            + this->readOperand(instruction, IMMEDIATE_C, instruction._c);
+        variables[instruction._a % VARIABLE_COUNT] = uint16_t(std::min(sum, int(UINT16_MAX)));
+        break;
+    }
+    case SUBTRACT: {
+        int difference = this->readOperand(instruction, IMMEDIATE_B, instruction._b)
+            - this->readOperand(instruction, IMMEDIATE_C, instruction._c);
+        variables[instruction._a % VARIABLE_COUNT] = uint16_t(std::max(difference, 0));
+        break;
+    }
+    case SLEEP:
+        this->_sleepTicks = instruction._a;
+        break;
+    case FOR:
+        // An empty loop, or one nested deeper than we keep frames for, is skipped
+        if (instruction._a == 0 || instruction._b == 0 || this->_loopDepth == MAX_LOOP_DEPTH) {
+            next += instruction._b;
+        }
+        else {
+            this->_loopStack[this->_loopDepth++] = { next, next + instruction._b, instruction._a };
+        }
+        break;
+    case READ: {
+        auto word = this->_memory.find(this->toAddress(instruction._b));
+        variables[instruction._a % VARIABLE_COUNT] = word == this->_memory.end() ? 0 : word->second;
+        break;
+    }
+    case WRITE:
+        this->_memory[this->toAddress(instruction._a)] = this->readOperand(instruction, IMMEDIATE_B, instruction._b);
+        break;
+    }
+
+    // Close every loop whose body ends here; the innermost one that still
+    // has iterations left jumps back to the top of its body.
+    while (this->_loopDepth > 0 && next == this->_loopStack[this->_loopDepth - 1].end) {
+        LoopFrame& frame = this->_loopStack[this->_loopDepth - 1];
+        if (--frame.remaining > 0) {
+            next = frame.start;
+            break;
+        }
+        this->_loopDepth--;
+    }
+
+    this->_pc = next;
+    // Single writer: a plain load and store, no read-modify-write
+    int counter = this->_commandCounter.load(std::memory_order_relaxed) + 1;
+    this->_commandCounter.store(counter, std::memory_order_relaxed);
+    this->_remainingBurst = this->_totalInstructions - counter;
+    if (this->_pc >= int(this->_instructions.size()) && this->_sleepTicks == 0) {
+        this->_finished.store(true, std::memory_order_release);
+    }
+    return true;
+}
+
+void Process::getNextAccess(int pageCount, int& codePage, int& dataPage, bool& write) {
+    codePage = -1;
+    dataPage = -1;
+    write = false;
+    if (pageCount <= 0 || this->_sleepTicks > 0 || this->hasFinished()) return;
+
+    // Code is laid out from address 0, wrapping around the process's memory
+    int pageSize = std::max(1, this->_requiredMemory / pageCount);
+    codePage = (this->_pc * int(sizeof(Instruction)) % this->_requiredMemory) / pageSize % pageCount;
+    const Instruction& instruction = this->_instructions[this->_pc];
+    if (instruction._type == READ) {
+        dataPage = this->toAddress(instruction._b) / pageSize % pageCount;
+    }
+    else if (instruction._type == WRITE) {
+        dataPage = this->toAddress(instruction._a) / pageSize % pageCount;
+        write = true;
     }
 }
 
-bool Process::hasFinished() {
-    if (this->_commandCounter >= this->_commandList.size()) {
-        return true;
+uint16_t Process::readOperand(const Instruction& instruction, uint8_t immediateFlag, uint16_t operand) const {
+    if (instruction._flags & immediateFlag) {
+        return operand;
     }
-    return false;
+    return this->_variables[operand % VARIABLE_COUNT];
+}
+
+// Operands address bytes of the process's own memory; words are 2-byte aligned
+int Process::toAddress(uint16_t operand) const {
+    return (operand % this->_requiredMemory) & ~1;
 }
 
 int Process::setRequiredPages(int min, int max) {
     if (Process::requiredPages == -1) {
         std::uniform_int_distribution<int>  pageDistr(min, max);
-        std::random_device rand_dev;
-        std::mt19937 generator(rand_dev());
+        std::mt19937 generator = Random::generator(Random::SIZES, 0);
         Process::requiredPages = pageDistr(generator);
         int power = 1;
         while (power < Process::requiredPages) {
@@ -78,8 +184,7 @@ int Process::setRequiredPages(int min, int max) {
 int Process::setRequiredMemory(int min, int max) {
     if (Process::sameMemory == -1) {
         std::uniform_int_distribution<int>  memDistr(min, max);
-        std::random_device rand_dev;
-        std::mt19937 generator(rand_dev());
+        std::mt19937 generator = Random::generator(Random::SIZES, 1);
         Process::sameMemory = memDistr(generator);
         int power = 1;
         while (power < Process::sameMemory) {
@@ -90,9 +195,37 @@ int Process::setRequiredMemory(int min, int max) {
     return Process::sameMemory;
 }
 
-void Process::setCPUCoreID(int cpuCoreID) {
-    std::lock_guard<std::mutex> lock(mtx);
-    this->_cpuCoreID = cpuCoreID;
+void Process::resetRequiredMemory() {
+    Process::sameMemory = -1;
+    Process::requiredPages = -1;
+}
+
+void Process::markArrived(long long tick) {
+    this->_arrivalTick = tick;
+    this->_readySince = tick;
+}
+
+void Process::markDispatched(long long tick) {
+    if (this->_firstDispatchTick == -1) {
+        this->_firstDispatchTick = tick;
+    }
+    else {
+        this->_contextSwitches++;
+    }
+    this->_waitTicks += tick - this->_readySince;
+}
+
+void Process::markDescheduled(long long tick) {
+    this->_readySince = tick;
+}
+
+void Process::markFinished(long long tick) {
+    this->_completionTick = tick;
+    this->setFinishTime();
+    // Nothing runs again, so the program and memory contents can go; only
+    // the counters and metrics are still reported
+    std::vector<Instruction>().swap(this->_instructions);
+    std::unordered_map<int, uint16_t>().swap(this->_memory);
 }
 
-int Process::nextID = 0;
\ No newline at end of file
+std::atomic<int> Process::nextID{ 0 };
\ No newline at end of file
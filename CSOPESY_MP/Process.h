@@ -8,10 +8,15 @@
 #include <vector>
 
 #include "ICommand.h"
-#include <mutex>
+#include <atomic>
+#include <cstdint>
 #include <random>
+#include <unordered_map>
 
 
+// Only the engine thread runs a process, so the interpreter state needs no
+// lock. What other threads read (status commands, process screens) is
+// either fixed at construction or an atomic the engine thread publishes.
 class Process {
 public:
     Process(std::string name,
@@ -19,44 +24,102 @@ public:
         std::uniform_int_distribution<int> memoryDistr,
         std::uniform_int_distribution<int> pageDistr
     );
+    // A process with a known shape, e.g. one replayed from a trace
+    Process(std::string name, int instructions, int memory);
     ~Process() = default;
 
-    void execute();
-    bool hasFinished();
+    // True if an instruction retired; false while asleep or once finished
+    bool execute();
+    bool hasFinished() const { return _finished.load(std::memory_order_acquire); };
+    // Engine thread only
+    bool isSleeping() const { return _sleepTicks > 0; };
+    // Pages the next instruction will touch, for demand paging: the one
+    // holding the instruction, and for READ/WRITE the one holding the word
+    // (-1 when there is none)
+    void getNextAccess(int pageCount, int& codePage, int& dataPage, bool& write);
 
     int getID() const { return _pid; };
-    std::string getName() { std::lock_guard<std::mutex> lock(mtx); return _name; };
-    int getCommandCounter() { std::lock_guard<std::mutex> lock(mtx); return _commandCounter; };
-    int getCommandListSize() { std::lock_guard<std::mutex> lock(mtx); return _commandList.size(); };
-    int getBurst() { return this->getCommandListSize() - this->getCommandCounter(); };
+    const std::string& getName() const { return _name; };
+    int getCommandCounter() const { return _commandCounter.load(std::memory_order_relaxed); };
+    int getCommandListSize() const { return _totalInstructions; };
+    int getBurst() const { return this->getCommandListSize() - this->getCommandCounter(); };
+    // Cached copy of getBurst(), only written by execute(); safe for hot comparisons
+    int getRemainingBurst() const { return _remainingBurst; };
+    int getPriorityLevel() const { return _priorityLevel; };
+    void setPriorityLevel(int level) { this->_priorityLevel = level; };
     time_t getArrivalTime() const { return _arrivalTime; };
     time_t getFinishTime() { return _finishTime; };
-    int getRequiredMemory() { std::lock_guard<std::mutex> lock(mtx); return _requiredMemory; };
+    int getRequiredMemory() const { return _requiredMemory; };
+    // The size actually drawn, before rounding up to a power of two or
+    // replacing it with the shared paging size
+    int getRequestedMemory() const { return _requestedMemory; };
     static int setRequiredPages(int min, int max);
     static int setRequiredMemory(int min, int max);
     static int getRequiredPages() { return Process::requiredPages; };
-    int getCPUCoreID() { std::lock_guard<std::mutex> lock(mtx); return _cpuCoreID; };
-
-    void setCPUCoreID(int cpuCoreID);
+    // Forget the fixed paging sizes so later processes draw their own again;
+    // only for runs that try several allocators, like the benchmarks
+    static void resetRequiredMemory();
+    int getCPUCoreID() const { return _cpuCoreID.load(std::memory_order_relaxed); };
+    void setCPUCoreID(int cpuCoreID) { this->_cpuCoreID.store(cpuCoreID, std::memory_order_relaxed); };
     void setFinishTime() { this->_finishTime = time(nullptr); };
 
+    // Scheduling metrics, in engine ticks. Written by the engine thread only.
+    void markArrived(long long tick);
+    void markDispatched(long long tick);
+    void markDescheduled(long long tick);
+    void markFinished(long long tick);
+    long long getArrivalTick() const { return _arrivalTick; };
+    long long getFirstDispatchTick() const { return _firstDispatchTick; };
+    long long getWaitTicks() const { return _waitTicks; };
+    int getContextSwitches() const { return _contextSwitches; };
+    long long getCompletionTick() const { return _completionTick; };
+
     bool operator<(std::shared_ptr<Process> other) {
         return this->getBurst() > other->getBurst();
     };
-    static int nextID;
+    static std::atomic<int> nextID;
 
 private:
-    std::mutex mtx;
+    struct LoopFrame {
+        int start;
+        int end;
+        int remaining;
+    };
+
+    void build(int instructions, int memory);
+    uint16_t readOperand(const Instruction& instruction, uint8_t immediateFlag, uint16_t operand) const;
+    int toAddress(uint16_t operand) const;
 
     int _pid;
     std::string _name;
-    std::vector<std::shared_ptr<ICommand>> _commandList;
-    int _commandCounter = 0;
-    int _cpuCoreID = -1;
+    std::vector<Instruction> _instructions;
+    // Interpreter state. _commandCounter counts executed instructions, which
+    // with loops can run past _instructions.size(); _pc indexes the program.
+    int _pc = 0;
+    int _sleepTicks = 0;
+    int _totalInstructions = 0;
+    uint16_t _variables[VARIABLE_COUNT] = {};
+    LoopFrame _loopStack[MAX_LOOP_DEPTH] = {};
+    int _loopDepth = 0;
+    // Sparse: most processes only ever touch a few words
+    std::unordered_map<int, uint16_t> _memory;
+    std::atomic<int> _commandCounter{ 0 };
+    std::atomic<bool> _finished{ false };
+    int _remainingBurst = 0;
+    int _priorityLevel = 0;
+    std::atomic<int> _cpuCoreID{ -1 };
     time_t _arrivalTime = time(nullptr);
     time_t _finishTime = time(nullptr);
 
+    long long _arrivalTick = 0;
+    long long _readySince = 0;
+    long long _firstDispatchTick = -1;
+    long long _waitTicks = 0;
+    int _contextSwitches = 0;
+    long long _completionTick = -1;
+
     int _requiredMemory;
+    int _requestedMemory;
     static int requiredPages;
     static int sameMemory;
 };
@@ -1,4 +1,5 @@
 #include "ProcessConsole.h"
+#include "Platform.h"
 #include <iostream>
 
 ProcessConsole::ProcessConsole(std::shared_ptr<Process> process) :
@@ -11,7 +12,7 @@ void ProcessConsole::run() {
 		this->_canRemove = true;
 		return;
 	}
-	system("cls");
+	Platform::clearScreen();
 	this->_active = true;
 	if (this->_history == "") {
 		this->draw();
@@ -0,0 +1,80 @@
+#include "ProgramGenerator.h"
+
+#include <algorithm>
+
+
+// Generated programs stick to a handful of variables so that arithmetic
+// actually reuses earlier results.
+static const int GENERATED_VARIABLES = 8;
+static const int MAX_REPEATS = 5;
+static const int MAX_LOOP_BODY = 8;
+
+void ProgramGenerator::generate(int instructions, std::mt19937& generator, std::vector<Instruction>& out) {
+    out.reserve(out.size() + instructions);
+    ProgramGenerator::generateBlock(instructions, 0, generator, out);
+}
+
+void ProgramGenerator::generateBlock(int budget, int depth, std::mt19937& generator, std::vector<Instruction>& out) {
+    std::uniform_int_distribution<int> percent(0, 99);
+    while (budget > 0) {
+        // A loop needs its header plus at least two iterations of one instruction
+        if (depth < MAX_LOOP_DEPTH && budget >= 3 && percent(generator) < 10) {
+            std::uniform_int_distribution<int> repeatDistr(2, MAX_REPEATS);
+            int repeats = repeatDistr(generator);
+            int maxBody = std::min(MAX_LOOP_BODY, (budget - 1) / repeats);
+            if (maxBody >= 1) {
+                std::uniform_int_distribution<int> bodyDistr(1, maxBody);
+                int bodyBudget = bodyDistr(generator);
+
+                size_t header = out.size();
+                out.push_back(Instruction{ FOR, 0, uint16_t(repeats), 0, 0 });
+                ProgramGenerator::generateBlock(bodyBudget, depth + 1, generator, out);
+                out[header]._b = uint16_t(out.size() - header - 1);
+                budget -= 1 + repeats * bodyBudget;
+                continue;
+            }
+        }
+        out.push_back(ProgramGenerator::generateSimple(generator));
+        budget--;
+    }
+}
+
+Instruction ProgramGenerator::generateSimple(std::mt19937& generator) {
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> variable(0, GENERATED_VARIABLES - 1);
+    std::uniform_int_distribution<int> literal(0, 1000);
+    std::uniform_int_distribution<int> address(0, 65535);
+
+    uint16_t a = uint16_t(variable(generator));
+    int roll = percent(generator);
+    if (roll < 30) {
+        uint8_t flags = percent(generator) < 50 ? PRINT_VARIABLE : 0;
+        return Instruction{ PRINT, flags, a, 0, 0 };
+    }
+    if (roll < 45) {
+        return Instruction{ DECLARE, 0, a, uint16_t(literal(generator)), 0 };
+    }
+    if (roll < 75) {
+        // Mix variable and literal sources
+        uint8_t flags = 0;
+        uint16_t b = uint16_t(variable(generator));
+        uint16_t c = uint16_t(variable(generator));
+        if (percent(generator) < 50) {
+            flags |= IMMEDIATE_B;
+            b = uint16_t(literal(generator));
+        }
+        if (percent(generator) < 50) {
+            flags |= IMMEDIATE_C;
+            c = uint16_t(literal(generator));
+        }
+        return Instruction{ roll < 60 ? ADD : SUBTRACT, flags, a, b, c };
+    }
+    if (roll < 80) {
+        std::uniform_int_distribution<int> ticks(1, 3);
+        return Instruction{ SLEEP, 0, uint16_t(ticks(generator)), 0, 0 };
+    }
+    if (roll < 90) {
+        return Instruction{ READ, 0, a, uint16_t(address(generator)), 0 };
+    }
+    return Instruction{ WRITE, 0, uint16_t(address(generator)), a, 0 };
+}
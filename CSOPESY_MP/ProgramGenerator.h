@@ -0,0 +1,24 @@
+#pragma once
+#ifndef PROGRAMGENERATOR_H
+#define PROGRAMGENERATOR_H
+
+#include <random>
+#include <vector>
+
+#include "ICommand.h"
+
+
+// Builds the random programs that generated processes run. Sizes are
+// counted in executed instructions, so a FOR header counts once and its
+// body counts once per iteration; that is what the scheduler sees as burst.
+class ProgramGenerator {
+public:
+    // Appends a program that executes exactly `instructions` instructions.
+    static void generate(int instructions, std::mt19937& generator, std::vector<Instruction>& out);
+
+private:
+    static void generateBlock(int budget, int depth, std::mt19937& generator, std::vector<Instruction>& out);
+    static Instruction generateSimple(std::mt19937& generator);
+};
+
+#endif // !PROGRAMGENERATOR_H
@@ -0,0 +1,39 @@
+#include "Random.h"
+
+#include <cstdint>
+#include <random>
+
+
+std::atomic<unsigned int> Random::seed{ 0 };
+
+void Random::setSeed(unsigned int seed) {
+    Random::seed = seed;
+}
+
+// Until a seed is set, the first caller picks one for the whole run
+unsigned int Random::getSeed() {
+    unsigned int current = Random::seed;
+    while (current == 0) {
+        std::random_device device;
+        unsigned int picked = device();
+        if (picked == 0) continue;
+        if (Random::seed.compare_exchange_strong(current, picked)) {
+            return picked;
+        }
+    }
+    return current;
+}
+
+// splitmix64 finaliser: nearby (stream, id) pairs still get unrelated seeds.
+// Cheaper than a std::seed_seq, which matters at one generator per process.
+static uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+std::mt19937 Random::generator(Stream stream, unsigned int id) {
+    uint64_t key = mix(Random::getSeed()) ^ ((uint64_t(stream) << 32) | id);
+    return std::mt19937(uint32_t(mix(key)));
+}
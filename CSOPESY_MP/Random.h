@@ -0,0 +1,31 @@
+#pragma once
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <atomic>
+#include <random>
+
+
+// Single source of randomness for the simulation. Every consumer gets its
+// own generator derived from the run's seed plus what it is for (e.g. the
+// PID), so a run is reproducible from its seed no matter which thread
+// creates what first, and nothing reads std::random_device per process.
+class Random {
+public:
+    enum Stream {
+        PROCESS,    // instruction count and memory size, per PID
+        PROGRAM,    // generated program, per PID
+        SIZES,      // the shared page count and page-mode memory size
+        EVICTION    // victim choice in the contiguous allocators
+    };
+
+    // 0 picks a seed from std::random_device
+    static void setSeed(unsigned int seed);
+    static unsigned int getSeed();
+    static std::mt19937 generator(Stream stream, unsigned int id = 0);
+
+private:
+    static std::atomic<unsigned int> seed;
+};
+
+#endif // !RANDOM_H
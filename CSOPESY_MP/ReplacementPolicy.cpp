@@ -0,0 +1,88 @@
+#include "ReplacementPolicy.h"
+
+
+IReplacementPolicy* IReplacementPolicy::create(const std::string& name, int frameCount) {
+    if (name == "lru") return new LRUReplacement(frameCount);
+    if (name == "clock") return new ClockReplacement(frameCount);
+    if (name == "second-chance") return new SecondChanceReplacement(frameCount);
+    return new FIFOReplacement(frameCount);
+}
+
+ListReplacement::ListReplacement(int frameCount) :
+    _position(frameCount), _tracked(frameCount, false) {
+}
+
+void ListReplacement::loaded(int frame) {
+    if (this->_tracked[frame]) {
+        this->_order.erase(this->_position[frame]);
+    }
+    this->_position[frame] = this->_order.insert(this->_order.end(), frame);
+    this->_tracked[frame] = true;
+}
+
+void ListReplacement::freed(int frame) {
+    if (this->_tracked[frame]) {
+        this->_order.erase(this->_position[frame]);
+        this->_tracked[frame] = false;
+    }
+}
+
+int ListReplacement::chooseVictim(const ReferenceTest& /*testAndClear*/) {
+    return this->popFront();
+}
+
+int ListReplacement::popFront() {
+    if (this->_order.empty()) return -1;
+    int frame = this->_order.front();
+    this->_order.pop_front();
+    this->_tracked[frame] = false;
+    return frame;
+}
+
+void LRUReplacement::accessed(int frame) {
+    if (this->_tracked[frame]) {
+        this->_order.splice(this->_order.end(), this->_order, this->_position[frame]);
+    }
+}
+
+int SecondChanceReplacement::chooseVictim(const ReferenceTest& testAndClear) {
+    // Terminates: every pass clears a bit, so each frame is skipped at most once
+    while (!this->_order.empty()) {
+        int frame = this->_order.front();
+        if (!testAndClear(frame)) {
+            return this->popFront();
+        }
+        this->_order.splice(this->_order.end(), this->_order, this->_order.begin());
+    }
+    return -1;
+}
+
+ClockReplacement::ClockReplacement(int frameCount) : _tracked(frameCount, false) {
+}
+
+void ClockReplacement::loaded(int frame) {
+    if (!this->_tracked[frame]) {
+        this->_tracked[frame] = true;
+        this->_trackedCount++;
+    }
+}
+
+void ClockReplacement::freed(int frame) {
+    if (this->_tracked[frame]) {
+        this->_tracked[frame] = false;
+        this->_trackedCount--;
+    }
+}
+
+int ClockReplacement::chooseVictim(const ReferenceTest& testAndClear) {
+    if (this->_trackedCount == 0) return -1;
+    int frames = int(this->_tracked.size());
+    while (true) {
+        int frame = this->_hand;
+        this->_hand = (this->_hand + 1) % frames;
+        if (this->_tracked[frame] && !testAndClear(frame)) {
+            this->freed(frame);
+            return frame;
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#ifndef REPLACEMENTPOLICY_H
+#define REPLACEMENTPOLICY_H
+
+#include <functional>
+#include <list>
+#include <string>
+#include <vector>
+
+
+// Decides which resident frame gives way when a page fault finds no free
+// frame. Policies only track frame numbers; the allocator owns the page
+// table and lets policies read-and-clear a frame's referenced bit.
+class IReplacementPolicy {
+public:
+    // Returns the frame's referenced bit and clears it
+    typedef std::function<bool(int frame)> ReferenceTest;
+
+    // "fifo", "lru", "clock" or "second-chance"; anything else is FIFO
+    static IReplacementPolicy* create(const std::string& name, int frameCount);
+
+    virtual ~IReplacementPolicy() = default;
+
+    virtual void loaded(int frame) = 0;
+    virtual void accessed(int /*frame*/) {}
+    // The frame was released by its owner rather than evicted
+    virtual void freed(int frame) = 0;
+    // Picks the frame to evict and stops tracking it
+    virtual int chooseVictim(const ReferenceTest& testAndClear) = 0;
+};
+
+// Frames queued in a list with O(1) removal; the base of FIFO, LRU and
+// second chance, which differ only in how the order is maintained.
+class ListReplacement : public IReplacementPolicy {
+public:
+    ListReplacement(int frameCount);
+
+    void loaded(int frame) override;
+    void freed(int frame) override;
+    int chooseVictim(const ReferenceTest& testAndClear) override;
+
+protected:
+    int popFront();
+
+    std::list<int> _order;
+    std::vector<std::list<int>::iterator> _position;
+    std::vector<bool> _tracked;
+};
+
+// Evicts the page that was loaded first
+class FIFOReplacement : public ListReplacement {
+public:
+    FIFOReplacement(int frameCount) : ListReplacement(frameCount) {};
+};
+
+// Evicts the page that was used longest ago
+class LRUReplacement : public ListReplacement {
+public:
+    LRUReplacement(int frameCount) : ListReplacement(frameCount) {};
+
+    void accessed(int frame) override;
+};
+
+// FIFO, except a referenced page has its bit cleared and goes to the back
+class SecondChanceReplacement : public ListReplacement {
+public:
+    SecondChanceReplacement(int frameCount) : ListReplacement(frameCount) {};
+
+    int chooseVictim(const ReferenceTest& testAndClear) override;
+};
+
+// Second chance without moving anything: a hand sweeps the frames in order
+class ClockReplacement : public IReplacementPolicy {
+public:
+    ClockReplacement(int frameCount);
+
+    void loaded(int frame) override;
+    void freed(int frame) override;
+    int chooseVictim(const ReferenceTest& testAndClear) override;
+
+private:
+    std::vector<bool> _tracked;
+    int _trackedCount = 0;
+    int _hand = 0;
+};
+
+#endif // !REPLACEMENTPOLICY_H
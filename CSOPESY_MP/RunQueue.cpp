@@ -0,0 +1,112 @@
+#include "RunQueue.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include "Process.h"
+
+
+void RunQueue::setLevels(int levels) {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    this->_levels.resize(std::max(1, levels));
+}
+
+void RunQueue::push(std::shared_ptr<Process> process) {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (this->_order == SHORTEST_FIRST) {
+        this->_shortest.push(process);
+    }
+    else if (this->_order == MULTILEVEL) {
+        int level = std::min(std::max(process->getPriorityLevel(), 0), int(this->_levels.size()) - 1);
+        this->_levels[level].push_back(process);
+    }
+    else {
+        this->_fifo.push_back(process);
+    }
+}
+
+std::shared_ptr<Process> RunQueue::front() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (this->_order == SHORTEST_FIRST) {
+        return this->_shortest.top();
+    }
+    if (this->_order == MULTILEVEL) {
+        for (size_t i = 0; i < this->_levels.size(); i++) {
+            if (!this->_levels[i].empty()) return this->_levels[i].front();
+        }
+        return nullptr;
+    }
+    return this->_fifo.empty() ? nullptr : this->_fifo.front();
+}
+
+void RunQueue::pop() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (this->_order == SHORTEST_FIRST) {
+        this->_shortest.pop();
+    }
+    else if (this->_order == MULTILEVEL) {
+        for (size_t i = 0; i < this->_levels.size(); i++) {
+            if (!this->_levels[i].empty()) {
+                this->_levels[i].pop_front();
+                break;
+            }
+        }
+    }
+    else if (!this->_fifo.empty()) {
+        this->_fifo.pop_front();
+    }
+}
+
+std::shared_ptr<Process> RunQueue::steal() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    std::shared_ptr<Process> process = nullptr;
+    if (this->_order == SHORTEST_FIRST) {
+        process = this->_shortest.pop();
+    }
+    else if (this->_order == MULTILEVEL) {
+        for (size_t i = this->_levels.size(); i > 0; i--) {
+            if (!this->_levels[i - 1].empty()) {
+                process = this->_levels[i - 1].back();
+                this->_levels[i - 1].pop_back();
+                break;
+            }
+        }
+    }
+    else if (!this->_fifo.empty()) {
+        process = this->_fifo.back();
+        this->_fifo.pop_back();
+    }
+    if (process != nullptr) {
+        this->_stealsOut++;
+    }
+    return process;
+}
+
+// Priority boost: everything queued goes back to the top level, oldest first.
+void RunQueue::boost() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (this->_order != MULTILEVEL) return;
+    for (size_t i = 1; i < this->_levels.size(); i++) {
+        for (size_t j = 0; j < this->_levels[i].size(); j++) {
+            this->_levels[i][j]->setPriorityLevel(0);
+            this->_levels[0].push_back(this->_levels[i][j]);
+        }
+        this->_levels[i].clear();
+    }
+}
+
+size_t RunQueue::size() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (this->_order == SHORTEST_FIRST) {
+        return this->_shortest.size();
+    }
+    if (this->_order == MULTILEVEL) {
+        size_t total = 0;
+        for (size_t i = 0; i < this->_levels.size(); i++) {
+            total += this->_levels[i].size();
+        }
+        return total;
+    }
+    return this->_fifo.size();
+}
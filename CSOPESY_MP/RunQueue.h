@@ -0,0 +1,60 @@
+#pragma once
+#ifndef RUNQUEUE_H
+#define RUNQUEUE_H
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "BurstHeap.h"
+#include "Process.h"
+
+
+// Ready queue owned by a single CPU. The owner takes work from the front;
+// an idle neighbour steals from the opposite end (the newest arrival in
+// FIFO order, the lowest priority level when multilevel) so the two rarely
+// want the same entry. A burst-ordered heap has no cheap far end, so there
+// the thief takes the shortest job, the same one the owner would.
+class RunQueue {
+public:
+    enum Order {
+        FIFO,
+        SHORTEST_FIRST,
+        MULTILEVEL
+    };
+
+    RunQueue() = default;
+    ~RunQueue() = default;
+
+    void setOrder(Order order) { this->_order = order; };
+    void setLevels(int levels);
+
+    void push(std::shared_ptr<Process> process);
+    std::shared_ptr<Process> front();
+    void pop();
+    std::shared_ptr<Process> steal();
+    void boost();
+
+    size_t size();
+    bool empty() { return this->size() == 0; };
+
+    int getStealsIn() const { return this->_stealsIn; };
+    int getStealsOut() const { return this->_stealsOut; };
+    void recordStealIn() { this->_stealsIn++; };
+
+private:
+    std::mutex mtx;
+    Order _order = FIFO;
+    std::deque<std::shared_ptr<Process>> _fifo;
+    BurstHeap _shortest;
+    // MULTILEVEL: one FIFO per priority level, level 0 first
+    std::vector<std::deque<std::shared_ptr<Process>>> _levels;
+
+    // Written on the engine thread, read by process-smi and vmstat
+    std::atomic<int> _stealsIn{ 0 };
+    std::atomic<int> _stealsOut{ 0 };
+};
+
+#endif // !RUNQUEUE_H
@@ -1,7 +1,9 @@
 #include "Config.h"
 #include "Scheduler.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <ctime>
 #include <iostream>
 #include <memory>
@@ -10,11 +12,23 @@
 #include <thread>
 
 #include "CPU.h"
+#include "EventEngine.h"
+#include "LogWriter.h"
 #include "MemoryManager.h"
+#include "Platform.h"
+#include "PrintCommand.h"
 #include "Process.h"
+#include "Random.h"
+#include "SnapshotWriter.h"
 
 Scheduler::Scheduler() {}
 
+Scheduler::~Scheduler() {
+    delete this->_memMan;
+    delete this->_recordTrace;
+    delete this->_replayTrace;
+}
+
 int Scheduler::getTotalTicks() {
     int total = 0;
     for (size_t i = 0; i < this->_cpuList.size(); i++) {
@@ -33,6 +47,93 @@ int Scheduler::getInactiveTicks() {
 
 Scheduler* Scheduler::_ptr = nullptr;
 
+bool Scheduler::startSimulation(const Config& config) {
+    // A replayed trace brings its own seed, so its programs come out the same
+    TraceFile* replay = nullptr;
+    if (config.getTraceReplay() != "") {
+        replay = new TraceFile();
+        if (!replay->openRead(config.getTraceReplay())) {
+            delete replay;
+            return false;
+        }
+    }
+    Random::setSeed(replay != nullptr && replay->getSeed() != 0 ? replay->getSeed() : config.getSeed());
+    TraceFile* record = nullptr;
+    if (config.getTraceRecord() != "") {
+        record = new TraceFile();
+        if (!record->openWrite(config.getTraceRecord(), Random::getSeed())) {
+            delete record;
+            delete replay;
+            return false;
+        }
+    }
+
+    EventEngine::initialize(config.isRealTime(), config.getMsPerTick());
+    LogWriter::initialize("output");
+    LogWriter::get()->start();
+    if (config.getMemoryStampDir() != "") {
+        SnapshotWriter::initialize(config.getMemoryStampDir());
+        SnapshotWriter::get()->start();
+    }
+
+    // Paging gives every process the same number of equal pages
+    if (config.getAllocator() == "paging") {
+        Process::setRequiredMemory(config.getMinMemProc(), config.getMaxMemProc());
+    }
+
+    Scheduler::initialize(config.getNumCpu(),
+        config.getBatchProcessFreq(),
+        config.getMinIns(), config.getMaxIns(),
+        config.getMinMemProc(), config.getMaxMemProc(),
+        config.getMaxMem(), config.getMinPageProc(), config.getMaxPageProc(),
+        config.getAllocator(), config.getFitPolicy(), config.getPageReplacement());
+
+    PrintCommand::setMsDelay(0);
+
+    Scheduler* sched = Scheduler::get();
+    sched->_retention = config.getFinishedRetention();
+    sched->setInstructionsPerTick(config.getInstructionsPerTick());
+    sched->_recordTrace = record;
+    sched->_replayTrace = replay;
+    if (replay != nullptr) {
+        sched->_hasNextArrival = replay->read(sched->_nextArrival);
+    }
+    std::string schedType = config.getScheduler();
+    if (schedType == "fcfs") {
+        sched->startFCFS();
+    }
+    else if (schedType == "sjf") {
+        sched->startSJF(config.isPreemptive());
+    }
+    else if (schedType == "rr") {
+        sched->startRR(config.getQuantumCycle());
+    }
+    else if (schedType == "mlfq") {
+        sched->startMLFQ(config.getQuantumCycle(),
+            config.getMlfqLevels(), config.getMlfqBoostTicks());
+    }
+
+    EventEngine::get()->start();
+    return true;
+}
+
+void Scheduler::stopSimulation() {
+    if (EventEngine::get() != nullptr) {
+        EventEngine::get()->stop();
+    }
+    Scheduler* sched = Scheduler::get();
+    if (sched != nullptr && sched->_recordTrace != nullptr) {
+        std::lock_guard<std::mutex> lock(sched->mtx);
+        sched->_recordTrace->close();
+    }
+    if (LogWriter::get() != nullptr) {
+        LogWriter::get()->stop();
+    }
+    if (SnapshotWriter::get() != nullptr) {
+        SnapshotWriter::get()->stop();
+    }
+}
+
 Scheduler* Scheduler::get() {
     return _ptr;
 }
@@ -41,7 +142,8 @@ void Scheduler::initialize(int cpuCount,
     float batchProcessFreq,
     int minIns, int maxIns,
     int minMemProc, int maxMemProc,
-    int maxMem, int minPage, int maxPage) {
+    int maxMem, int minPage, int maxPage,
+    std::string allocator, std::string fitPolicy, std::string replacement) {
     _ptr = new Scheduler();
     for (int i = 0; i < cpuCount; i++) {
         _ptr->_cpuList.push_back(std::make_shared<CPU>());
@@ -53,29 +155,58 @@ void Scheduler::initialize(int cpuCount,
     _ptr->_maxMemProc = maxMemProc;
     _ptr->_minPage = minPage;
     _ptr->_maxPage = maxPage;
-    _ptr->_memMan = new MemoryManager(maxMem, minPage, maxPage);
+    _ptr->_memMan = new MemoryManager(maxMem, minPage, maxPage, allocator, fitPolicy, replacement);
 }
 
-void Scheduler::startFCFS(int delay) {
+void Scheduler::startFCFS() {
     if (this->running == false) {
         this->running = true;
-        std::thread t(&Scheduler::runFCFS, this, delay);
-        t.detach();
+        this->_dispatch = [this]() { this->runFCFS(); };
     }
 }
-void Scheduler::startSJF(int delay, bool preemptive) {
+void Scheduler::startSJF(bool preemptive) {
     if (this->running == false) {
         this->running = true;
-        std::thread t(&Scheduler::runSJF, this, delay, preemptive);
-        t.detach();
+        for (std::shared_ptr<CPU> cpu : this->_cpuList) {
+            cpu->getRunQueue().setOrder(RunQueue::SHORTEST_FIRST);
+        }
+        this->_dispatch = [this, preemptive]() { this->runSJF(preemptive); };
     }
 }
 
-void Scheduler::startRR(int delay, int quantumCycles) {
+void Scheduler::startRR(int quantumCycles) {
     if (this->running == false) {
         this->running = true;
-        std::thread t(&Scheduler::runRR, this, delay, quantumCycles);
-        t.detach();
+        this->_quantumCycles = std::max(1, quantumCycles);
+        this->_stampQuanta = true;
+        for (std::shared_ptr<CPU> cpu : this->_cpuList) {
+            cpu->setQuantum(this->_quantumCycles);
+        }
+        this->_dispatch = [this]() { this->runRR(); };
+    }
+}
+
+// Same per-core tick quantum as RR, but level n gets quantumCycles << n
+// instructions, a process that uses up its slice drops a level, and every
+// boostTicks all processes are lifted back to level 0.
+void Scheduler::startMLFQ(int quantumCycles, int levels, int boostTicks) {
+    if (this->running == false) {
+        this->running = true;
+        this->_quantumCycles = std::max(1, quantumCycles);
+        this->_mlfqLevels = std::max(1, levels);
+        this->_mlfqBoostTicks = boostTicks;
+        this->_lastBoost = EventEngine::get()->getTick();
+        for (std::shared_ptr<CPU> cpu : this->_cpuList) {
+            cpu->getRunQueue().setOrder(RunQueue::MULTILEVEL);
+            cpu->getRunQueue().setLevels(this->_mlfqLevels);
+        }
+        this->_dispatch = [this]() { this->runMLFQ(); };
+    }
+}
+
+void Scheduler::setInstructionsPerTick(int count) {
+    for (std::shared_ptr<CPU> cpu : this->_cpuList) {
+        cpu->setInstructionsPerTick(std::max(1, count));
     }
 }
 
@@ -83,19 +214,118 @@ void Scheduler::stop() {
     this->running = false;
 }
 
+// The engine must not still hold callbacks into the scheduler: stop it, or
+// let it run everything queued, first
 void Scheduler::destroy() {
     delete _ptr;
+    _ptr = nullptr;
 }
 
+// Safe from any thread and never blocks on the scheduler: the process goes
+// onto a lock-free queue, and only the producer that finds it empty has to
+// wake the engine to drain it.
 void Scheduler::addProcess(std::shared_ptr<Process> process) {
+    if (this->_admissionQueue.push(process)) {
+        EventEngine::get()->post([this]() { this->admitProcesses(); });
+    }
+}
+
+// Engine thread: deal everything admitted so far round-robin onto the
+// per-core run queues.
+void Scheduler::admitProcesses() {
+    std::vector<std::shared_ptr<Process>> admitted;
+    if (this->_admissionQueue.drain(admitted) == 0) return;
+    long long tick = EventEngine::get()->getTick();
+    for (size_t i = 0; i < admitted.size(); i++) {
+        admitted[i]->markArrived(tick);
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->_admittedCount += int(admitted.size());
+        for (size_t i = 0; i < admitted.size(); i++) {
+            int pid = admitted[i]->getID();
+            this->_processByPid[pid] = admitted[i];
+            this->_pidByName[admitted[i]->getName()] = pid;
+            if (this->_recordTrace != nullptr) {
+                this->_recordTrace->write({ tick, admitted[i]->getCommandListSize(), admitted[i]->getRequestedMemory(),
+                    admitted[i]->getPriorityLevel() });
+            }
+        }
+    }
+    for (size_t i = 0; i < admitted.size(); i++) {
+        this->_cpuList.at(this->_nextQueue)->getRunQueue().push(admitted[i]);
+        this->_nextQueue = (this->_nextQueue + 1) % this->_cpuList.size();
+    }
+    this->requestDispatch();
+}
+
+int Scheduler::findPid(const std::string& name) {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    auto entry = this->_pidByName.find(name);
+    return entry == this->_pidByName.end() ? -1 : entry->second;
+}
+
+std::shared_ptr<Process> Scheduler::getProcess(int pid) {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    auto entry = this->_processByPid.find(pid);
+    return entry == this->_processByPid.end() ? nullptr : entry->second;
+}
+
+// Engine thread. Latencies are taken now, so they outlive the process.
+void Scheduler::recordFinished(const std::shared_ptr<Process>& process) {
     std::lock_guard<std::mutex> lock(this->mtx);
-    if (Config::_scheduler == "sjf") {
-        this->_readyQueueSJF.push(process);
+    this->_finished.waiting.push_back(process->getWaitTicks());
+    this->_finished.turnaround.push_back(process->getCompletionTick() - process->getArrivalTick());
+    this->_finished.response.push_back(process->getFirstDispatchTick() - process->getArrivalTick());
+    this->_finished.contextSwitches += process->getContextSwitches();
+    this->_finishedList.push_back(process);
+    while (this->_retention >= 0 && int(this->_finishedList.size()) > this->_retention) {
+        std::shared_ptr<Process> oldest = this->_finishedList.front();
+        this->_finishedList.pop_front();
+        this->_processByPid.erase(oldest->getID());
+        auto name = this->_pidByName.find(oldest->getName());
+        if (name != this->_pidByName.end() && name->second == oldest->getID()) {
+            this->_pidByName.erase(name);
+        }
     }
-    else {
-        this->_readyQueue.push(process);
+    this->_finishedCount++;
+}
+
+// Called for an idle core whose own queue is empty: take one process from
+// the most loaded neighbour.
+bool Scheduler::stealWork(size_t index) {
+    int victim = -1;
+    size_t most = 0;
+    for (size_t i = 0; i < this->_cpuList.size(); i++) {
+        if (i == index) continue;
+        size_t size = this->_cpuList.at(i)->getRunQueue().size();
+        if (size > most) {
+            most = size;
+            victim = int(i);
+        }
+    }
+    if (victim != -1) {
+        std::shared_ptr<Process> process = this->_cpuList.at(victim)->getRunQueue().steal();
+        if (process != nullptr) {
+            RunQueue& queue = this->_cpuList.at(index)->getRunQueue();
+            queue.push(process);
+            queue.recordStealIn();
+            return true;
+        }
     }
-    this->_processList.push_back(process);
+    this->_failedSteals++;
+    return false;
+}
+
+// Dispatch only runs in response to an event (arrival, a core going idle,
+// quantum expiry); repeated requests within a tick collapse into one pass.
+void Scheduler::requestDispatch() {
+    if (this->_dispatchPending) return;
+    this->_dispatchPending = true;
+    EventEngine::get()->schedule(0, [this]() {
+        this->_dispatchPending = false;
+        if (this->running) this->_dispatch();
+        });
 }
 
 void Scheduler::printStatus() {
@@ -118,20 +348,21 @@ void Scheduler::printStatus() {
     }
     std::cout << std::endl;
     std::cout << "Running processes:" << std::endl;
-    for (int i = 0; i < this->_cpuList.size(); i++) {
+    for (size_t i = 0; i < this->_cpuList.size(); i++) {
         std::shared_ptr<CPU> cpu = this->_cpuList.at(i);
-        if (cpu->isReady()) {
+        std::shared_ptr<Process> running = cpu->getProcess();
+        if (cpu->isReady() || running == nullptr) {
             std::cout << "Idle\tCore: " << std::to_string(cpu->getId()) << std::endl;
         }
         else {
-            std::string process = cpu->getProcessName();
-            std::string commandCounter = std::to_string(cpu->getProcessCommandCounter());
-            std::string totalCommands = std::to_string(cpu->getProcessCommandListSize());
+            std::string process = running->getName();
+            std::string commandCounter = std::to_string(running->getCommandCounter());
+            std::string totalCommands = std::to_string(running->getCommandListSize());
             std::string cpuID = std::to_string(cpu->getId());
 
-            auto timestamp = cpu->getProcessArrivalTime();
+            auto timestamp = running->getArrivalTime();
             struct tm timeInfo;
-            localtime_s(&timeInfo, &timestamp);
+            Platform::localTime(&timeInfo, &timestamp);
             char buffer[80];
             strftime(buffer, sizeof(buffer), "(%D %r)", &timeInfo);
 
@@ -142,20 +373,19 @@ void Scheduler::printStatus() {
 
     std::cout << "Finished processes:" << std::endl;
 
-    for (int i = 0; i < this->_processList.size(); i++) {
-        if (this->_processList.at(i)->hasFinished()) {
-            std::string process = this->_processList.at(i)->getName();
-            std::string commandCounter = std::to_string(this->_processList.at(i)->getCommandCounter());
-            std::string totalCommands = std::to_string(this->_processList.at(i)->getCommandListSize());
+    for (size_t i = 0; i < this->_finishedList.size(); i++) {
+        std::shared_ptr<Process> finished = this->_finishedList[i];
+        std::string process = finished->getName();
+        std::string commandCounter = std::to_string(finished->getCommandCounter());
+        std::string totalCommands = std::to_string(finished->getCommandListSize());
 
-            auto timestamp = this->_processList.at(i)->getFinishTime();
-            struct tm timeInfo;
-            localtime_s(&timeInfo, &timestamp);
-            char buffer[80];
-            strftime(buffer, sizeof(buffer), "(%D %r)", &timeInfo);
+        auto timestamp = finished->getFinishTime();
+        struct tm timeInfo;
+        Platform::localTime(&timeInfo, &timestamp);
+        char buffer[80];
+        strftime(buffer, sizeof(buffer), "(%D %r)", &timeInfo);
 
-            std::cout << process + "\t" + buffer + "\t" + "Finished" + "\t" + commandCounter + " / " + totalCommands << std::endl;
-        }
+        std::cout << process + "\t" + buffer + "\t" + "Finished" + "\t" + commandCounter + " / " + totalCommands << std::endl;
     }
     for (int i = 0; i < 38; i++) {
         std::cout << "-";
@@ -163,176 +393,340 @@ void Scheduler::printStatus() {
     std::cout << std::endl;
 }
 
+// Nearest-rank percentile of an already sorted sample.
+long long Scheduler::percentile(const std::vector<long long>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t rank = size_t(p / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+double Scheduler::mean(const std::vector<long long>& values) {
+    if (values.empty()) return 0;
+    double total = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        total += values[i];
+    }
+    return total / values.size();
+}
+
+Scheduler::Latencies Scheduler::getLatencies() {
+    Latencies latencies;
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        latencies = this->_finished;
+    }
+    std::sort(latencies.waiting.begin(), latencies.waiting.end());
+    std::sort(latencies.turnaround.begin(), latencies.turnaround.end());
+    std::sort(latencies.response.begin(), latencies.response.end());
+    return latencies;
+}
+
+void Scheduler::printStats() {
+    Latencies latencies = this->getLatencies();
+
+    std::cout << "Finished processes: " << latencies.waiting.size() << std::endl;
+    if (latencies.waiting.empty()) return;
+
+    const char* names[] = { "Waiting", "Turnaround", "Response" };
+    std::vector<long long>* samples[] = { &latencies.waiting, &latencies.turnaround, &latencies.response };
+    printf("%-12s %12s %12s %12s\n", "(ticks)", "mean", "p50", "p99");
+    for (int i = 0; i < 3; i++) {
+        printf("%-12s %12.1f %12lld %12lld\n", names[i],
+            mean(*samples[i]), percentile(*samples[i], 50), percentile(*samples[i], 99));
+    }
+    printf("Context switches per process: %.2f\n", double(latencies.contextSwitches) / latencies.waiting.size());
+}
+
 void Scheduler::printMem() {
-    this->_memMan->printMem(this->_cycleCount);
+    this->_memMan->printMem(std::cout);
 }
 
-void Scheduler::schedulerTest() {
-    std::cout << "Started adding processes." << std::endl;
+void Scheduler::schedulerTest(int count) {
+    if (this->_testRunning) {
+        std::cout << "scheduler-test is already running; use scheduler-stop first." << std::endl;
+        return;
+    }
+    int run = ++this->_testRun;
+    this->_testRemaining = count;
     this->_testRunning = true;
-    std::thread t(&Scheduler::schedulerRun, this);
-    t.detach();
+    if (this->_replayTrace != nullptr) {
+        EventEngine::get()->post([this, run]() {
+            // The next arrival is due now: the first one when starting, or
+            // the one a scheduler-stop left off at when resuming
+            this->_replayStart = EventEngine::get()->getTick() - this->_nextArrival.tick;
+            this->replayArrivals(run);
+            });
+    }
+    else if (EventEngine::get()->isRealTime()) {
+        std::thread t(&Scheduler::schedulerRun, this, run);
+        t.detach();
+    }
+    else {
+        EventEngine::get()->post([this, run]() { this->generateProcess(run); });
+    }
 }
 
-void Scheduler::schedulerRun() {
+std::shared_ptr<Process> Scheduler::createProcess(std::string name) {
     std::uniform_int_distribution<int>  commandDistr(this->minIns, this->maxIns);
     std::uniform_int_distribution<int>  memDistr(this->_minMemProc, this->_maxMemProc);
     std::uniform_int_distribution<int>  pageDistr(this->_minPage, this->_maxPage);
-    while (this->_testRunning) {
-        std::shared_ptr<Process> process = std::make_shared<Process>("process_" + std::to_string(Process::nextID), commandDistr, memDistr, pageDistr);
-        this->addProcess(process);
+    if (name == "") {
+        name = "process_" + std::to_string(Process::nextID);
+    }
+    return std::make_shared<Process>(name, commandDistr, memDistr, pageDistr);
+}
+
+// Real-time mode: arrivals are paced on the wall clock like before.
+void Scheduler::schedulerRun(int run) {
+    while (this->isTestRunning(run)) {
+        this->addProcess(this->createProcess());
+        if (this->_testRemaining > 0 && --this->_testRemaining == 0) {
+            this->_testRunning = false;
+            break;
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(int(this->batchProcessFreq * 100)));
     }
 
 }
 
+// Fast mode: one arrival every batch-process-freq virtual ticks.
+void Scheduler::generateProcess(int run) {
+    if (!this->isTestRunning(run)) return;
+    this->addProcess(this->createProcess());
+    if (this->_testRemaining > 0 && --this->_testRemaining == 0) {
+        this->_testRunning = false;
+        return;
+    }
+    long long interval = std::max(1LL, (long long)this->batchProcessFreq);
+    EventEngine::get()->schedule(interval, [this, run]() { this->generateProcess(run); });
+}
+
+// Replay, in either mode: create every traced arrival that is due, then
+// wake up again at the next one. Only one line of the trace is held at a
+// time, so traces of any length replay in constant memory.
+void Scheduler::replayArrivals(int run) {
+    if (!this->isTestRunning(run)) return;
+    long long elapsed = EventEngine::get()->getTick() - this->_replayStart;
+    while (this->_hasNextArrival && this->_nextArrival.tick <= elapsed) {
+        // Logs without a memory column get the configured minimum
+        int memory = this->_nextArrival.memory > 0 ? this->_nextArrival.memory : this->_minMemProc;
+        std::shared_ptr<Process> process = std::make_shared<Process>("process_" + std::to_string(Process::nextID),
+            this->_nextArrival.instructions, memory);
+        process->setPriorityLevel(std::min(this->_nextArrival.priority, this->_mlfqLevels - 1));
+        this->addProcess(process);
+        this->_hasNextArrival = this->_replayTrace->read(this->_nextArrival);
+        if (this->_testRemaining > 0 && --this->_testRemaining == 0) {
+            this->_testRunning = false;
+            return;
+        }
+    }
+    if (!this->_hasNextArrival) {
+        this->_testRunning = false;
+        return;
+    }
+    EventEngine::get()->schedule(this->_nextArrival.tick - elapsed, [this, run]() { this->replayArrivals(run); });
+}
+
+bool Scheduler::isDrained() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    return !this->_testRunning && this->_admissionQueue.empty()
+        && this->_finishedCount == this->_admittedCount;
+}
+
 void Scheduler::schedulerTestStop() {
     this->_testRunning = false;
     std::cout << "Stopped adding processes." << std::endl;
 }
 
-void Scheduler::runFCFS(float delay) { // FCFS
-    while (this->running) {
-        for (int i = 0; i < this->_cpuList.size(); i++) {
-            std::shared_ptr<CPU> cpu = this->_cpuList.at(i);
-            if (cpu->isReady()) {
-                if (cpu->getProcess() != nullptr && cpu->getProcess()->hasFinished()) {
-                    _memMan->deallocate(cpu->getProcess());
-                }
-                if (this->_readyQueue.size() > 0) {
-                    if (_memMan->allocate(this->_readyQueue.front())) {
-                        cpu->setProcess(this->_readyQueue.front());
-                        this->_readyQueue.pop();
-                        this->running = true;
-                    }
+void Scheduler::runFCFS() { // FCFS
+    for (size_t i = 0; i < this->_cpuList.size(); i++) {
+        std::shared_ptr<CPU> cpu = this->_cpuList.at(i);
+        RunQueue& queue = cpu->getRunQueue();
+        if (cpu->isReady()) {
+            if (cpu->getProcess() != nullptr && cpu->getProcess()->hasFinished()) {
+                _memMan->deallocate(cpu->getProcess());
+            }
+            if (queue.empty()) {
+                this->stealWork(i);
+            }
+            if (queue.size() > 0) {
+                if (_memMan->allocate(queue.front())) {
+                    cpu->setProcess(queue.front());
+                    queue.pop();
                 }
             }
-            //else {
-            //    if (this->running == false) {
-            //        std::chrono::duration<float> duration(delay);
-            //        std::this_thread::sleep_for(duration);
-            //        this->running = true;
-            //    }
-            //}
         }
     }
 }
 
-void Scheduler::runSJF(float delay, bool preemptive) { // SJF
-    std::unique_lock<std::mutex> lock(this->mtx);
-    lock.unlock();
+void Scheduler::runSJF(bool preemptive) { // SJF
     if (preemptive) {
-        while (this->running) {
-            lock.lock();
-            for (int i = 0; i < this->_cpuList.size(); i++) {
-                std::shared_ptr<CPU> cpu = this->_cpuList.at(i);
-                std::shared_ptr<Process> oldProcess = cpu->getProcess();
-                if (oldProcess != nullptr && oldProcess->hasFinished()) {
-                    _memMan->deallocate(oldProcess);
-                }
+        // Only touch a core when its queue holds a strictly shorter job than
+        // the one it is running; everything else stays where it is.
+        for (size_t i = 0; i < this->_cpuList.size(); i++) {
+            std::shared_ptr<CPU> cpu = this->_cpuList.at(i);
+            RunQueue& queue = cpu->getRunQueue();
+            std::shared_ptr<Process> oldProcess = cpu->getProcess();
+            if (oldProcess != nullptr && oldProcess->hasFinished()) {
+                _memMan->deallocate(oldProcess);
                 cpu->setProcess(nullptr);
+                oldProcess = nullptr;
+            }
 
-                if (oldProcess != nullptr && !oldProcess->hasFinished()) this->_readyQueueSJF.push(oldProcess);
+            if (oldProcess == nullptr && queue.empty()) {
+                this->stealWork(i);
+            }
+            if (queue.empty()) continue;
 
-                if (!this->_readyQueueSJF.empty()) {
-                    std::shared_ptr<Process> newProcess = this->_readyQueueSJF.top();
-                    this->_readyQueueSJF.pop();
-                    if (_memMan->allocate(newProcess)) {
-                        cpu->setProcess(newProcess);
-                    }
-                    else {
-                        this->_readyQueueSJF.push(newProcess);
-                    }
-                }
+            if (oldProcess != nullptr) {
+                if (queue.front()->getRemainingBurst() >= oldProcess->getRemainingBurst()) continue;
+                cpu->setProcess(nullptr);
+                queue.push(oldProcess);
+            }
+
+            std::shared_ptr<Process> newProcess = this->takeAllocatable(queue);
+            if (newProcess != nullptr) {
+                cpu->setProcess(newProcess);
             }
-            lock.unlock();
         }
     }
     else {
-        while (this->running) {
-            for (int i = 0; i < this->_cpuList.size(); i++) {
-                std::shared_ptr<CPU> cpu = this->_cpuList.at(i);
-                if (cpu->isReady()) {
-                    if (cpu->getProcess() != nullptr && cpu->getProcess()->hasFinished()) {
-                        _memMan->deallocate(cpu->getProcess());
-                        cpu->setProcess(nullptr);
-                    }
-                    if (this->_readyQueueSJF.size() > 0) {
-                        if (_memMan->allocate(this->_readyQueueSJF.top())) {
-                            cpu->setProcess(this->_readyQueueSJF.top());
-                            this->_readyQueueSJF.pop();
-                            this->running = true;
-                        }
+        for (size_t i = 0; i < this->_cpuList.size(); i++) {
+            std::shared_ptr<CPU> cpu = this->_cpuList.at(i);
+            RunQueue& queue = cpu->getRunQueue();
+            if (cpu->isReady()) {
+                if (cpu->getProcess() != nullptr && cpu->getProcess()->hasFinished()) {
+                    _memMan->deallocate(cpu->getProcess());
+                    cpu->setProcess(nullptr);
+                }
+                if (queue.empty()) {
+                    this->stealWork(i);
+                }
+                if (queue.size() > 0) {
+                    if (_memMan->allocate(queue.front())) {
+                        cpu->setProcess(queue.front());
+                        queue.pop();
                     }
                 }
-                //else {
-                //    if (this->running == false) {
-                //        std::chrono::duration<float> duration(delay);
-                //        std::this_thread::sleep_for(duration);
-                //        this->running = true;
-                //    }
-                //}
             }
         }
     }
 }
 
-void Scheduler::runRR(float delay, int quantumCycles) { // RR
-    auto start = std::chrono::steady_clock::now();
-    this->_cycleCount = 0;
-    while (this->running) {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - start).count();
+// Pops the first queued process that memory can be found for. Preempted
+// processes stay resident, so when memory is full the ones behind them are
+// passed over (and requeued) instead of stalling the core until the next event.
+std::shared_ptr<Process> Scheduler::takeAllocatable(RunQueue& queue) {
+    std::vector<std::shared_ptr<Process>> skipped;
+    std::shared_ptr<Process> found = nullptr;
+    size_t tries = queue.size();
+    for (size_t i = 0; i < tries && found == nullptr; i++) {
+        std::shared_ptr<Process> process = queue.front();
+        queue.pop();
+        if (_memMan->allocate(process)) {
+            found = process;
+        }
+        else {
+            skipped.push_back(process);
+        }
+    }
+    for (size_t i = 0; i < skipped.size(); i++) {
+        queue.push(skipped[i]);
+    }
+    return found;
+}
 
-        // Check if quantum cycle limit exceeded
+// Each core counts the instructions it retires and yields its process after
+// quantum-cycles of them, so the slice is per core and measured in ticks.
+void Scheduler::runRR() { // RR
+    for (size_t i = 0; i < this->_cpuList.size(); i++) {
+        std::shared_ptr<CPU> cpu = this->_cpuList.at(i);
+        RunQueue& queue = cpu->getRunQueue();
+        if (cpu->getProcess() != nullptr && cpu->getProcess()->hasFinished()) {
+            _memMan->deallocate(cpu->getProcess());
+            cpu->setProcess(nullptr);
+            cpu->setReady();
+        }
+        else if (cpu->isQuantumExpired()) {
+            // Push current process back to ready queue
+            //_memMan->deallocate(cpu->getProcess()); // TO UNCOMMENT
+            queue.push(cpu->getProcess());
+            cpu->setProcess(nullptr);
+            cpu->setReady();
+        }
 
-        if (elapsed > quantumCycles) {
-            for (int i = 0; i < this->_cpuList.size(); i++) {
-                std::shared_ptr<CPU> cpu = this->_cpuList.at(i);
-                if (cpu->getProcess() != nullptr) {
-                    // Push current process back to ready queue
-                    //_memMan->deallocate(cpu->getProcess()); // TO UNCOMMENT
-                    this->_readyQueue.push(cpu->getProcess());
-                    cpu->setProcess(nullptr);
-                    cpu->setReady();
-                    this->running = true; // Set running to true to continue scheduling
-                }
+        if (cpu->isReady() && queue.empty()) {
+            this->stealWork(i);
+        }
+        if (cpu->isReady()) {
+            std::shared_ptr<Process> process = this->takeAllocatable(queue);
+            if (process != nullptr) {
+                process->setCPUCoreID(cpu->getId());
+                cpu->setProcess(process);
             }
-            start = std::chrono::steady_clock::now(); // Reset start time for new cycle
-            this->_cycleCount++;
         }
+    }
+}
 
-        // Assign processes to CPUs
-        for (int i = 0; i < this->_cpuList.size(); i++) {
-            std::shared_ptr<CPU> cpu = this->_cpuList.at(i);
-            if (cpu->getProcess() != nullptr && cpu->getProcess()->hasFinished()) {
-                _memMan->deallocate(cpu->getProcess());
-                cpu->setProcess(nullptr);
-                cpu->setReady();
-            }
-            if (cpu->isReady() && !this->_readyQueue.empty()) {
-                std::shared_ptr<Process> process = this->_readyQueue.front();
-
-                if (_memMan->allocate(process)) {
-                    process->setCPUCoreID(cpu->getId());
-                    cpu->setProcess(process);
-                    this->_readyQueue.pop();
-                    this->running = true;
-                }
-                else {
-                    this->_readyQueue.pop();
-                    this->_readyQueue.push(process);
-                }
-                start = std::chrono::steady_clock::now(); // Reset start time for the new process
+// Taken before the dispatch pass, so each stamp shows memory exactly as it
+// was when the slice ended.
+void Scheduler::recordQuantumExpired() {
+    SnapshotWriter* writer = SnapshotWriter::get();
+    if (!this->_stampQuanta || writer == nullptr) return;
+    long long tick = EventEngine::get()->getTick();
+    if (tick == this->_lastStampTick) return;
+    this->_lastStampTick = tick;
+    MemorySnapshot snapshot;
+    this->_memMan->snapshot(snapshot);
+    writer->submit(this->_stampCycle++, std::move(snapshot));
+}
+
+void Scheduler::runMLFQ() { // MLFQ
+    // Boosting is checked lazily on each dispatch pass rather than on a
+    // timer, so an idle simulation has nothing left to wake up for.
+    if (this->_mlfqBoostTicks > 0 && EventEngine::get()->getTick() - this->_lastBoost >= this->_mlfqBoostTicks) {
+        this->boostPriorities();
+    }
+
+    for (size_t i = 0; i < this->_cpuList.size(); i++) {
+        std::shared_ptr<CPU> cpu = this->_cpuList.at(i);
+        RunQueue& queue = cpu->getRunQueue();
+        if (cpu->getProcess() != nullptr && cpu->getProcess()->hasFinished()) {
+            _memMan->deallocate(cpu->getProcess());
+            cpu->setProcess(nullptr);
+            cpu->setReady();
+        }
+        else if (cpu->isQuantumExpired()) {
+            // Used its whole slice: demote one level
+            std::shared_ptr<Process> process = cpu->getProcess();
+            process->setPriorityLevel(std::min(process->getPriorityLevel() + 1, this->_mlfqLevels - 1));
+            queue.push(process);
+            cpu->setProcess(nullptr);
+            cpu->setReady();
+        }
+
+        if (cpu->isReady() && queue.empty()) {
+            this->stealWork(i);
+        }
+        if (cpu->isReady()) {
+            std::shared_ptr<Process> process = this->takeAllocatable(queue);
+            if (process != nullptr) {
+                process->setCPUCoreID(cpu->getId());
+                cpu->setQuantum(this->_quantumCycles << std::min(process->getPriorityLevel(), 20));
+                cpu->setProcess(process);
             }
         }
+    }
+}
 
-        //// If no tasks were scheduled, sleep for delay
-        //if (!this->running) {
-        //    std::chrono::duration<float> duration(delay);
-        //    std::this_thread::sleep_for(duration);
-        //    this->running = true; // Set running to true to continue scheduling
-        //}
+void Scheduler::boostPriorities() {
+    this->_lastBoost = EventEngine::get()->getTick();
+    for (size_t i = 0; i < this->_cpuList.size(); i++) {
+        this->_cpuList.at(i)->getRunQueue().boost();
+        std::shared_ptr<Process> running = this->_cpuList.at(i)->getProcess();
+        if (running != nullptr) {
+            running->setPriorityLevel(0);
+        }
     }
 }
 
@@ -351,7 +745,7 @@ void Scheduler::processSmi() {
 
     int cpuUse = 100 / this->_cpuList.size();
     int cpuUsage = 0;
-    for (int i = 0; i < this->_cpuList.size(); i++) {
+    for (size_t i = 0; i < this->_cpuList.size(); i++) {
         if (this->_cpuList[i]->getProcess() != nullptr) {
             cpuUsage += cpuUse;
         }
@@ -359,11 +753,23 @@ void Scheduler::processSmi() {
 
     std::cout << "CPU-Util: " << cpuUsage << "%" << std::endl;
 
-    this->_memMan->getAllocator()->printProcesses();
+    int steals = 0;
+    for (size_t i = 0; i < this->_cpuList.size(); i++) {
+        RunQueue& queue = this->_cpuList[i]->getRunQueue();
+        steals += queue.getStealsIn();
+        std::cout << "Core " << this->_cpuList[i]->getId() << ": "
+            << queue.size() << " queued, "
+            << queue.getStealsIn() << " stolen in, "
+            << queue.getStealsOut() << " stolen out" << std::endl;
+    }
+    std::cout << "Work steals: " << steals << " (" << this->_failedSteals << " found nothing)" << std::endl;
+    std::cout << std::endl;
+
+    this->_memMan->printProcesses(std::cout);
 }
 
 void Scheduler::vmstat() {
-    this->_memMan->vmstat();
+    this->_memMan->vmstat(std::cout);
 }
 
 
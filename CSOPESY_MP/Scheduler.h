@@ -2,68 +2,134 @@
 
 #ifndef SCHEDULER_H
 #define SCHEDULER_H
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <queue>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "CPU.h"
 #include "MemoryManager.h"
+#include "MPSCQueue.h"
 #include "Process.h"
+#include "TraceFile.h"
 #include <mutex>
 
 using namespace std;
 
-struct compare {
-    bool operator()(shared_ptr<Process> a, shared_ptr<Process> b) {
-        return a->getBurst() > b->getBurst();
-    }
-};
+class Config;
 
 class Scheduler {
 public:
-    static Scheduler* get();
+    // Finished-process latencies in ticks, each sorted ascending
+    struct Latencies {
+        std::vector<long long> waiting;
+        std::vector<long long> turnaround;
+        std::vector<long long> response;
+        long long contextSwitches = 0;
+    };
 
-    void startFCFS(int delay);
-    void startSJF(int delay, bool preemptive);
-    void startRR(int delay, int quantumCycles);
+    static Scheduler* get();
+    // Brings up the event engine, output writers and the scheduler the
+    // config asks for, and starts the clock. False, with nothing started, if
+    // a trace file cannot be opened.
+    static bool startSimulation(const Config& config);
+    // Stops the clock and writes out everything still buffered. Only for
+    // program exit; nothing starts the engine or the writers again
+    static void stopSimulation();
+
+    void startFCFS();
+    void startSJF(bool preemptive);
+    void startRR(int quantumCycles);
+    void startMLFQ(int quantumCycles, int levels, int boostTicks);
+    // How many instructions each core retires per tick
+    void setInstructionsPerTick(int count);
     void stop();
     void destroy();
     static void initialize(int cpuCount,
         float batchProcessFreq,
         int minIns, int maxIns,
         int minMemProc, int maxMemProc,
-        int maxMem, int minPage, int maxPage);
+        int maxMem, int minPage, int maxPage,
+        std::string allocator, std::string fitPolicy, std::string replacement);
     void addProcess(std::shared_ptr<Process> process);
-    void schedulerTest();
+    void requestDispatch();
+    void schedulerTest(int count = -1);
     void schedulerTestStop();
 
     void printStatus();
+    void printStats();
     void printMem();
     void processSmi();
     void vmstat();
 
-private:
-    Scheduler();
-    ~Scheduler() = default;
-
     int getTotalTicks();
     int getInactiveTicks();
+    int getFinishedCount() const { return this->_finishedCount; };
+    // True once arrivals have stopped and every admitted process has finished
+    bool isDrained();
+    // Called by a CPU when its process retires its last instruction
+    void recordFinished(const std::shared_ptr<Process>& process);
+    // Called by a CPU when its quantum runs out
+    void recordQuantumExpired();
+    Latencies getLatencies();
+    static long long percentile(const std::vector<long long>& sorted, double p);
+    static double mean(const std::vector<long long>& values);
+
+    MemoryManager* getMemoryManager() { return this->_memMan; };
+    // -1 if no admitted process has this name
+    int findPid(const std::string& name);
+    std::shared_ptr<Process> getProcess(int pid);
 
-    std::mutex mtx;
+private:
+    Scheduler();
+    ~Scheduler();
 
-    void runFCFS(float delay); // FCFS
-    void runSJF(float delay, bool preemptive); // SJF
-    void runRR(float delay, int quantumCycles); // RR
+    std::mutex mtx;
 
-    void schedulerRun();
+    void runFCFS(); // FCFS
+    void runSJF(bool preemptive); // SJF
+    void runRR(); // RR
+    void runMLFQ(); // MLFQ
+    void boostPriorities();
+
+    void admitProcesses();
+    bool stealWork(size_t index);
+    std::shared_ptr<Process> takeAllocatable(RunQueue& queue);
+
+    // A random process within the configured limits; named process_<pid>
+    // unless a name is given
+    std::shared_ptr<Process> createProcess(std::string name = "");
+    // Each scheduler-test run has its own id, so an arrival chain left over
+    // from a stopped run ends instead of running alongside a new one
+    bool isTestRunning(int run) const { return this->_testRunning && this->_testRun == run; };
+    void schedulerRun(int run);
+    void generateProcess(int run);
+    void replayArrivals(int run);
 
     static Scheduler* _ptr;
 
-    queue<shared_ptr<Process>> _readyQueue;
     vector<shared_ptr<CPU>> _cpuList;
-    vector<shared_ptr<Process>> _processList;
-    priority_queue<shared_ptr<Process>, std::vector<shared_ptr<Process>>, compare> _readyQueueSJF;
+    MPSCQueue<shared_ptr<Process>> _admissionQueue;
+    int _nextQueue = 0;
+    std::atomic<int> _failedSteals{ 0 };
+    std::atomic<int> _finishedCount{ 0 };
     MemoryManager* _memMan = nullptr;
+    // Admitted processes by PID, and the PID behind each name for console
+    // lookups. Everything below is guarded by mtx.
+    std::unordered_map<int, std::shared_ptr<Process>> _processByPid;
+    std::unordered_map<std::string, int> _pidByName;
+    int _admittedCount = 0;
+    // Finished processes in the order they finished, for report-util. With
+    // _retention >= 0 only the latest that many are kept; older ones are
+    // dropped from the lookups too. Latencies of every finished process are
+    // kept in _finished either way.
+    std::deque<std::shared_ptr<Process>> _finishedList;
+    int _retention = -1;
+    Latencies _finished;
 
     float batchProcessFreq;
     int minIns;
@@ -72,13 +138,36 @@ private:
     int _maxMemProc;
     int _minPage;
     int _maxPage;
-    int _cycleCount;
-
-    bool _testRunning = false;
+    int _quantumCycles = 1;
+    int _mlfqLevels = 1;
+    int _mlfqBoostTicks = 0;
+    long long _lastBoost = 0;
+    // RR stamps the memory layout at each quantum boundary; cores whose
+    // quanta run out on the same tick share one stamp
+    bool _stampQuanta = false;
+    long long _stampCycle = 0;
+    long long _lastStampTick = -1;
+
+    // Arrivals are appended to _recordTrace as they are admitted. With
+    // _replayTrace, scheduler-test creates the traced processes instead of
+    // random ones; _nextArrival is the next one not yet created.
+    TraceFile* _recordTrace = nullptr;
+    TraceFile* _replayTrace = nullptr;
+    TraceFile::Arrival _nextArrival = {};
+    bool _hasNextArrival = false;
+    long long _replayStart = 0;
+
+    std::function<void()> _dispatch;
+    bool _dispatchPending = false;
+    // Set on the console thread, read by the engine and arrival threads
+    std::atomic<bool> _testRunning{ false };
+    std::atomic<int> _testRun{ 0 };
+    int _testRemaining = -1;
     bool running = false;
     friend class ConsoleManager;
     friend class FlatAllocator;
     friend class PagingAllocator;
+    friend class BuddyAllocator;
 };
 
 #endif // SCHEDULER_H
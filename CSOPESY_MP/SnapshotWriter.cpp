@@ -0,0 +1,96 @@
+#include "SnapshotWriter.h"
+
+#include <fstream>
+#include <iostream>
+
+#include "Platform.h"
+
+
+// Snapshots waiting to be written before new ones are dropped
+static const size_t MAX_PENDING = 64;
+
+SnapshotWriter* SnapshotWriter::_ptr = nullptr;
+
+SnapshotWriter* SnapshotWriter::get() {
+    return SnapshotWriter::_ptr;
+}
+
+void SnapshotWriter::initialize(std::string directory) {
+    SnapshotWriter::_ptr = new SnapshotWriter(directory);
+}
+
+void SnapshotWriter::destroy() {
+    delete SnapshotWriter::_ptr;
+    SnapshotWriter::_ptr = nullptr;
+}
+
+SnapshotWriter::SnapshotWriter(std::string directory) : _directory(directory) {
+    Platform::makeDirectory(directory);
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    this->stop();
+}
+
+void SnapshotWriter::start() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (this->running == false) {
+        this->running = true;
+        this->_thread = std::thread(&SnapshotWriter::run, this);
+    }
+}
+
+void SnapshotWriter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->running = false;
+    }
+    this->cv.notify_all();
+    if (this->_thread.joinable()) {
+        this->_thread.join();
+    }
+}
+
+bool SnapshotWriter::submit(long long cycle, MemorySnapshot snapshot) {
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        if (!this->running || this->_pending.size() >= MAX_PENDING) {
+            this->_dropped++;
+            return false;
+        }
+        this->_pending.emplace_back(cycle, std::move(snapshot));
+    }
+    this->cv.notify_one();
+    return true;
+}
+
+int SnapshotWriter::getDropped() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    return this->_dropped;
+}
+
+void SnapshotWriter::run() {
+    std::unique_lock<std::mutex> lock(this->mtx);
+    while (true) {
+        this->cv.wait(lock, [this]() {
+            return !this->running || !this->_pending.empty();
+            });
+        if (this->_pending.empty()) break;
+        std::pair<long long, MemorySnapshot> next = std::move(this->_pending.front());
+        this->_pending.pop_front();
+
+        lock.unlock();
+        this->write(next.first, next.second);
+        lock.lock();
+    }
+}
+
+void SnapshotWriter::write(long long cycle, const MemorySnapshot& snapshot) {
+    std::string filename = this->_directory + "/memory_stamp_" + std::to_string(cycle) + ".txt";
+    std::ofstream output(filename, std::ios::out | std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << filename << " failed to open" << std::endl;
+        return;
+    }
+    snapshot.print(output);
+}
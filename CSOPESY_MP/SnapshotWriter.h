@@ -0,0 +1,52 @@
+#pragma once
+#ifndef SNAPSHOTWRITER_H
+#define SNAPSHOTWRITER_H
+
+#include "MemorySnapshot.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+
+// Writes memory snapshots to <directory>/memory_stamp_<cycle>.txt from its
+// own thread, so the scheduler only pays for taking the copy. If the writer
+// falls behind, new snapshots are dropped rather than queued without bound.
+class SnapshotWriter {
+public:
+    static SnapshotWriter* get();
+    static void initialize(std::string directory);
+    static void destroy();
+
+    void start();
+    // Writes everything queued so far and stops the writer thread
+    void stop();
+
+    // Returns false if the snapshot was dropped
+    bool submit(long long cycle, MemorySnapshot snapshot);
+    int getDropped();
+
+private:
+    SnapshotWriter(std::string directory);
+    ~SnapshotWriter();
+
+    void run();
+    void write(long long cycle, const MemorySnapshot& snapshot);
+
+    static SnapshotWriter* _ptr;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<std::pair<long long, MemorySnapshot>> _pending;
+    int _dropped = 0;
+
+    std::string _directory;
+
+    std::thread _thread;
+    bool running = false;
+};
+
+#endif // !SNAPSHOTWRITER_H
@@ -0,0 +1,71 @@
+#include "TraceFile.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+
+bool TraceFile::openWrite(const std::string& path, unsigned int seed) {
+    this->_out.open(path, std::ios::out | std::ios::trunc);
+    if (!this->_out.is_open()) {
+        std::cerr << "Failed to open " << path << "." << std::endl;
+        return false;
+    }
+    this->_seed = seed;
+    this->_out << "# seed " << seed << "\n";
+    this->_out << "# arrival-tick instructions memory priority\n";
+    return true;
+}
+
+void TraceFile::write(const Arrival& arrival) {
+    this->_out << arrival.tick << " " << arrival.instructions << " " << arrival.memory << " " << arrival.priority << "\n";
+}
+
+bool TraceFile::openRead(const std::string& path) {
+    this->_in.open(path);
+    if (!this->_in.is_open()) {
+        std::cerr << "Failed to open " << path << "." << std::endl;
+        return false;
+    }
+    while (this->_in.peek() == '#') {
+        std::string line;
+        std::getline(this->_in, line);
+        std::istringstream fields(line.substr(1));
+        std::string key;
+        unsigned int seed = 0;
+        if (fields >> key >> seed && key == "seed") {
+            this->_seed = seed;
+        }
+    }
+    return true;
+}
+
+bool TraceFile::read(Arrival& arrival) {
+    std::string line;
+    while (std::getline(this->_in, line)) {
+        if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream fields(line);
+        if (!(fields >> arrival.tick >> arrival.instructions) || arrival.tick < 0 || arrival.instructions <= 0) {
+            continue;
+        }
+        if (!(fields >> arrival.memory) || arrival.memory < 0) {
+            arrival.memory = 0;
+        }
+        if (!(fields >> arrival.priority) || arrival.priority < 0) {
+            arrival.priority = 0;
+        }
+        return true;
+    }
+    return false;
+}
+
+void TraceFile::close() {
+    if (this->_out.is_open()) {
+        this->_out.close();
+    }
+    if (this->_in.is_open()) {
+        this->_in.close();
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#ifndef TRACEFILE_H
+#define TRACEFILE_H
+
+#include <fstream>
+#include <string>
+
+
+// Workload trace, one process arrival per line:
+//     <arrival tick> <instructions> [<memory> [<priority>]]
+// Fields are separated by whitespace or commas, so CSV exports of real
+// arrival logs work too. Ticks only matter relative to the first arrival.
+// A missing or non-positive memory size is left as 0 for the scheduler to
+// fill in; priority is the initial MLFQ level (0 is the top). Lines starting
+// with '#' or ';' are comments, except "# seed <n>", which records the seed
+// the programs were generated from; any other line that does not parse (a
+// header, say) is skipped. Reading is incremental, one arrival at a time.
+class TraceFile {
+public:
+    struct Arrival {
+        long long tick;
+        int instructions;
+        int memory;
+        int priority;
+    };
+
+    TraceFile() = default;
+    ~TraceFile() = default;
+
+    bool openWrite(const std::string& path, unsigned int seed);
+    void write(const Arrival& arrival);
+    // Reads up to the first arrival, picking up the seed if there is one
+    bool openRead(const std::string& path);
+    // False at the end of the trace; malformed lines are skipped
+    bool read(Arrival& arrival);
+    void close();
+
+    // 0 if the trace did not record one
+    unsigned int getSeed() const { return this->_seed; };
+
+private:
+    std::ofstream _out;
+    std::ifstream _in;
+    unsigned int _seed = 0;
+};
+
+#endif // !TRACEFILE_H
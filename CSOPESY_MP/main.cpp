@@ -1,7 +1,13 @@
+#include "BatchRunner.h"
 #include "ConsoleManager.h"
 
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Any arguments select the non-interactive batch mode
+    if (argc > 1) {
+        return BatchRunner::run(argc, argv);
+    }
+
     // init
     ConsoleManager::initialize();
     ConsoleManager* conman = ConsoleManager::get();
@@ -10,4 +16,4 @@ int main() {
     conman->start();
 
     return 0;
-}
\ No newline at end of file
+}